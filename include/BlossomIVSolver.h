@@ -1,6 +1,7 @@
 #pragma once
 #include "Solver.h"
 #include "BlossomVertex.h"
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <iostream>
@@ -12,17 +13,30 @@ namespace maxmatching {
 	private:
 		/* List of all vertices. */
 		std::vector<BlossomVertex<Label>*> vertices;
-		std::vector<std::pair< BlossomVertex<Label>*, BlossomVertex<Label>*>> edges;
-		std::vector<unsigned int> edgeWeights;
+		/* Id of the first vertex. Vertices of one solver are created consecutively,
+		 * so the index of a vertex for Blossom IV follows from its id. */
+		unsigned int firstId;
+		/* Edge list and edge lengths in the format of Blossom IV,
+		 * i.e. the ends of edge i are elist[2 * i] and elist[2 * i + 1] */
+		std::vector<int> elist;
+		std::vector<int> elen;
 		int* matches;
 		int n_matches;
+		/* If set, every vertex v has a mirror vertex with index getIndex(v) + 1,
+		 * connected by an edge of length 0, which guarantees a perfect matching. */
 		bool duplicateInstance;
+
+		int getIndex(BlossomVertex<Label>* v);
+		void addNativeEdge(int u, int v, int length);
+		bool isOriginalMatch(int i);
+		BlossomVertex<Label>* getVertex(int index);
 	public:
 		BlossomIVSolver();
 		inline explicit BlossomIVSolver(unsigned int arg1, unsigned int arg2)
 			: vertices()
-			, edges()
-			, edgeWeights()
+			, firstId(0)
+			, elist()
+			, elen()
 			, matches(nullptr)
 			, n_matches(0)
 			, duplicateInstance(arg1>0){
@@ -30,10 +44,12 @@ namespace maxmatching {
 		};
 		~BlossomIVSolver();
 
+		void readGraph(SimpleGraph<Label>* g);
 		void addVertex(BlossomVertex<Label>* v);
 		void addEdge(BlossomVertex<Label>* u, BlossomVertex<Label>* v);
 		void calculateMaxMatching();
 		std::vector<BlossomVertex<Label>*>* getMatchingRepresentatives();
+		void getMatchingMates(unsigned int* mates);
 		std::vector<std::pair<Label, Label>>* getMatchingLabels();
 		void reset();
 		void clearVertices();
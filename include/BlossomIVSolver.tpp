@@ -17,81 +17,120 @@ namespace maxmatching {
 	}
 
 
+	template <class Label>
+	int BlossomIVSolver<Label>::getIndex(BlossomVertex<Label>* v) {
+		return (v->id - this->firstId) * (this->duplicateInstance ? 2 : 1);
+	}
+
+	template <class Label>
+	void BlossomIVSolver<Label>::addNativeEdge(int u, int v, int length) {
+		this->elist.push_back(u);
+		this->elist.push_back(v);
+		this->elen.push_back(length);
+	}
+
+	/* Fills the edge arrays of Blossom IV with their exact size
+	 * in a single pass over the graph. */
+	template <class Label>
+	void BlossomIVSolver<Label>::readGraph(SimpleGraph<Label>* g) {
+		unsigned int n = g->getVertexCount();
+		unsigned int m = g->getEdgeCount();
+		unsigned int nEdges = this->duplicateInstance ? 2 * m + n : m;
+		this->elist.reserve(this->elist.size() + 2 * nEdges);
+		this->elen.reserve(this->elen.size() + nEdges);
+		/* Maps the index in the simple graph to the index in Blossom IV */
+		std::vector<int> indices(n);
+		this->vertices.reserve(this->vertices.size() + n);
+		for (auto vIndex : g->order) {
+			auto vLabel = g->vertexLabel[vIndex];
+			auto v = new BlossomVertex<Label>(vLabel);
+			this->addVertex(v);
+			indices[vIndex] = this->getIndex(v);
+		}
+		for (auto vIndex : g->order) {
+			int u = indices[vIndex];
+			auto adjList = g->adjacencies[vIndex];
+			for (auto it2 = adjList->begin(); it2 != adjList->end(); it2++) {
+				int v = indices[*it2];
+				if (u < v) {
+					this->addNativeEdge(u, v, -1);
+					if (this->duplicateInstance) {
+						this->addNativeEdge(u + 1, v + 1, -1);
+					}
+				}
+			}
+		}
+	}
+
 	template <class Label>
 	void BlossomIVSolver<Label>::addVertex(BlossomVertex<Label>* v) {
+		if (this->vertices.empty()) {
+			this->firstId = v->id;
+		}
 		this->vertices.push_back(v);
 		if (this->duplicateInstance) {
-			BlossomVertex<Label>* vm = new BlossomVertex<Label>(v->label);
-			vm->mirror = v;
-			v->mirror = vm;
-			this->vertices.push_back(vm);
-			this->edges.push_back({ v, vm });
-			this->edgeWeights.push_back(0);
+			int index = this->getIndex(v);
+			this->addNativeEdge(index, index + 1, 0);
 		}
 	}
 
 	template <class Label>
 	void BlossomIVSolver<Label>::addEdge(BlossomVertex<Label>* u, BlossomVertex<Label>* v) {
-		this->edges.push_back({ u, v });
-		this->edgeWeights.push_back(1);
+		int ui = this->getIndex(u), vi = this->getIndex(v);
+		this->addNativeEdge(ui, vi, -1);
 		if (this->duplicateInstance) {
-			this->edges.push_back({ u->mirror, v->mirror });
-			this->edgeWeights.push_back(1);
+			this->addNativeEdge(ui + 1, vi + 1, -1);
 		}
 	}
 
 	template <class Label>
 	void BlossomIVSolver<Label>::calculateMaxMatching() {
 		this->reset();
-		int* elist = new int[2 * this->edges.size()];
-		int* elen = new int[this->edges.size()];
-		unsigned int i = 0;
-		auto it = this->edges.begin();
-		auto wit = this->edgeWeights.begin();
-		for (; it != this->edges.end(); it++, wit++) {
-			auto e = *it;
-			unsigned int w = *wit;
-			elist[2 * i] = e.first->id;
-			elist[2 * i + 1] = e.second->id;
-			elen[i] = -1*w;
-			i++;
-		}
+		int nNodes = this->vertices.size() * (this->duplicateInstance ? 2 : 1);
+		/* Blossom IV reads the arrays in place */
+		int* elistPtr = this->elist.data();
+		int* elenPtr = this->elen.data();
 		int just_frac = 0;
 		int	no_frac = 1;
 		int use_all_trees = 0;
 		int partialprice = 0;
 
-		this->matches = new int[this->vertices.size()];
+		this->matches = new int[nNodes];
 		this->n_matches = 0;
 
 		perfect_match_mod(
-			this->vertices.size(),
-			this->edges.size(),
-			&elist,
-			&elen,
+			nNodes,
+			this->elen.size(),
+			&elistPtr,
+			&elenPtr,
 			just_frac,
 			no_frac,
 			use_all_trees,
 			partialprice,
 			this->matches,
 			&this->n_matches);
+	}
+
+	/* Returns whether the i-th matching edge is part of the original instance */
+	template <class Label>
+	bool BlossomIVSolver<Label>::isOriginalMatch(int i) {
+		int u = this->matches[2 * i], v = this->matches[2 * i + 1];
+		return !this->duplicateInstance || (u % 2 == 0 && v % 2 == 0);
+	}
 
-		delete[](elist);
-		delete[](elen);
+	template <class Label>
+	BlossomVertex<Label>* BlossomIVSolver<Label>::getVertex(int index) {
+		return this->vertices[this->duplicateInstance ? index / 2 : index];
 	}
 
 	template <class Label>
 	std::vector<BlossomVertex<Label>*>* BlossomIVSolver<Label>::getMatchingRepresentatives() {
 		std::vector<BlossomVertex<Label>*>* ret = new std::vector<BlossomVertex<Label>*>();
 		for (int i = 0; i < this->n_matches; i++) {
-			auto u = this->vertices[this->matches[2 * i]];
-			auto v = this->vertices[this->matches[2 * i + 1]];
-			if (!this->duplicateInstance || (u->mirror != v && this->matches[2 * i] % 2 == 0)) {
-				ret->push_back(u);
+			if (this->isOriginalMatch(i)) {
+				ret->push_back(this->getVertex(this->matches[2 * i]));
 			}
 		}
-		std::cout << n_matches << "\n";
-		std::cout << ret->size() << "\n"; 
 		return ret;
 	}
 
@@ -99,15 +138,28 @@ namespace maxmatching {
 	std::vector<std::pair<Label, Label>>* BlossomIVSolver<Label>::getMatchingLabels() {
 		auto ret = new std::vector<std::pair<Label, Label>>();
 		for (int i = 0; i < this->n_matches; i++) {
-			auto u = this->vertices[this->matches[2 * i]];
-			auto v = this->vertices[this->matches[2 * i + 1]];
-			if (!this->duplicateInstance || (u->mirror != v && this->matches[2 * i] % 2 == 0)) {
+			if (this->isOriginalMatch(i)) {
+				auto u = this->getVertex(this->matches[2 * i]);
+				auto v = this->getVertex(this->matches[2 * i + 1]);
 				ret->push_back({ u->label, v->label });
 			}
 		}
 		return ret;
 	}
 
+	template <class Label>
+	void BlossomIVSolver<Label>::getMatchingMates(unsigned int* mates) {
+		std::fill(mates, mates + this->vertices.size(), NoMate);
+		int factor = this->duplicateInstance ? 2 : 1;
+		for (int i = 0; i < this->n_matches; i++) {
+			if (this->isOriginalMatch(i)) {
+				int u = this->matches[2 * i] / factor, v = this->matches[2 * i + 1] / factor;
+				mates[u] = v;
+				mates[v] = u;
+			}
+		}
+	}
+
 	template <class Label>
 	void BlossomIVSolver<Label>::reset() {
 		if (this->matches != nullptr) {
@@ -120,8 +172,8 @@ namespace maxmatching {
 	template <class Label>
 	void BlossomIVSolver<Label>::clearVertices() {
 		this->reset();
-		this->edges.clear();
-		this->edgeWeights.clear();
+		this->elist.clear();
+		this->elen.clear();
 		while (!this->vertices.empty()) {
 			BlossomVertex<Label>* v = this->vertices.back();
 			this->vertices.pop_back();
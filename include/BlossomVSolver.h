@@ -13,25 +13,42 @@ namespace maxmatching {
 	private:
 		/* List of all vertices. */
 		std::vector<BlossomVertex<Label>*> vertices;
-		std::vector<std::pair< BlossomVertex<Label>*, BlossomVertex<Label>*>> edges;
+		/* Id of the first vertex. Vertices of one solver are created consecutively,
+		 * so the index of a vertex for Blossom V follows from its id. */
+		unsigned int firstId;
+		/* Edges added by addEdge as pairs of Blossom V indices with their weights.
+		 * These are only staged, if the graph is not read by readGraph. */
+		std::vector<int> edges;
+		std::vector<int> edgeWeights;
+		/* The Blossom V instance, created directly by readGraph */
+		PerfectMatching* pm;
 		std::vector<std::pair< BlossomVertex<Label>*, BlossomVertex<Label>*>> matches;
-		std::vector<unsigned int> edgeWeights;
+		/* If set, every vertex v has a mirror vertex with index getIndex(v) + 1,
+		 * connected by an edge of weight 0, which guarantees a perfect matching. */
 		bool duplicateInstance;
+
+		int getIndex(BlossomVertex<Label>* v);
+		void addNativeEdge(int u, int v, int weight);
 	public:
 		BlossomVSolver();
 		inline BlossomVSolver(unsigned int arg1, unsigned int arg2)
 			: vertices()
+			, firstId(0)
 			, edges()
+			, edgeWeights()
+			, pm(nullptr)
 			, matches()
 			, duplicateInstance(arg1 > 0) {
 			(void)arg2;
 		};
 		~BlossomVSolver();
 
+		void readGraph(SimpleGraph<Label>* g);
 		void addVertex(BlossomVertex<Label>* v);
 		void addEdge(BlossomVertex<Label>* u, BlossomVertex<Label>* v);
 		void calculateMaxMatching();
 		std::vector<BlossomVertex<Label>*>* getMatchingRepresentatives();
+		void getMatchingMates(unsigned int* mates);
 		std::vector<std::pair<Label, Label>>* getMatchingLabels();
 		void reset();
 		void clearVertices();
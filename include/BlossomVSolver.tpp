@@ -8,56 +8,107 @@ namespace maxmatching {
 	template <class Label>
 	BlossomVSolver<Label>::~BlossomVSolver() {
 		this->reset();
+		delete(this->pm);
 	}
 
 
+	template <class Label>
+	int BlossomVSolver<Label>::getIndex(BlossomVertex<Label>* v) {
+		return (v->id - this->firstId) * (this->duplicateInstance ? 2 : 1);
+	}
+
+	/* Adds an edge either directly to the Blossom V instance or stages it */
+	template <class Label>
+	void BlossomVSolver<Label>::addNativeEdge(int u, int v, int weight) {
+		if (this->pm != nullptr) {
+			this->pm->AddEdge(u, v, weight);
+		} else {
+			this->edges.push_back(u);
+			this->edges.push_back(v);
+			this->edgeWeights.push_back(weight);
+		}
+	}
+
+	/* Creates the Blossom V instance with the exact number of nodes and edges
+	 * and adds the edges in a single pass over the graph. */
+	template <class Label>
+	void BlossomVSolver<Label>::readGraph(SimpleGraph<Label>* g) {
+		unsigned int n = g->getVertexCount();
+		unsigned int m = g->getEdgeCount();
+		delete(this->pm);
+		this->pm = this->duplicateInstance
+			? new PerfectMatching(2 * n, 2 * m + n)
+			: new PerfectMatching(n, m);
+		/* Maps the index in the simple graph to the index in Blossom V */
+		std::vector<int> indices(n);
+		this->vertices.reserve(n);
+		for (auto vIndex : g->order) {
+			auto vLabel = g->vertexLabel[vIndex];
+			auto v = new BlossomVertex<Label>(vLabel);
+			this->addVertex(v);
+			indices[vIndex] = this->getIndex(v);
+		}
+		for (auto vIndex : g->order) {
+			int u = indices[vIndex];
+			auto adjList = g->adjacencies[vIndex];
+			for (auto it2 = adjList->begin(); it2 != adjList->end(); it2++) {
+				int v = indices[*it2];
+				if (u < v) {
+					this->pm->AddEdge(u, v, -1);
+					if (this->duplicateInstance) {
+						this->pm->AddEdge(u + 1, v + 1, -1);
+					}
+				}
+			}
+		}
+	}
+
 	template <class Label>
 	void BlossomVSolver<Label>::addVertex(BlossomVertex<Label>* v) {
+		if (this->vertices.empty()) {
+			this->firstId = v->id;
+		}
 		this->vertices.push_back(v);
 		if (this->duplicateInstance) {
-			BlossomVertex<Label>* vm = new BlossomVertex<Label>(v->label);
-			vm->mirror = v;
-			v->mirror = vm;
-			this->vertices.push_back(vm);
-			this->edges.push_back({ v, vm });
-			this->edgeWeights.push_back(0);
+			int index = this->getIndex(v);
+			this->addNativeEdge(index, index + 1, 0);
 		}
 	}
 
 	template <class Label>
 	void BlossomVSolver<Label>::addEdge(BlossomVertex<Label>* u, BlossomVertex<Label>* v) {
-		this->edges.push_back({ u, v });
-		this->edgeWeights.push_back(1);
+		int ui = this->getIndex(u), vi = this->getIndex(v);
+		this->addNativeEdge(ui, vi, -1);
 		if (this->duplicateInstance) {
-			this->edges.push_back({ u->mirror, v->mirror });
-			this->edgeWeights.push_back(1);
+			this->addNativeEdge(ui + 1, vi + 1, -1);
 		}
 	}
 
 	template <class Label>
 	void BlossomVSolver<Label>::calculateMaxMatching() {
-		PerfectMatching pm(this->vertices.size(), this->edges.size());
-		auto it = this->edges.begin();
-		auto wit = this->edgeWeights.begin();
-		for (; it != this->edges.end(); it++, wit++) {
-			auto e = *it;
-			unsigned int w = *wit;
-			BlossomVertex<Label>* u = e.first;
-			BlossomVertex<Label>* v = e.second;
-			pm.AddEdge(u->id, v->id, -1*w);
+		unsigned int nNodes = this->vertices.size() * (this->duplicateInstance ? 2 : 1);
+		if (this->pm == nullptr) {
+			this->pm = new PerfectMatching(nNodes, this->edgeWeights.size());
+			for (unsigned int i = 0; i < this->edgeWeights.size(); i++) {
+				this->pm->AddEdge(this->edges[2 * i], this->edges[2 * i + 1], this->edgeWeights[i]);
+			}
+			this->edges.clear();
+			this->edgeWeights.clear();
 		}
 		PerfectMatching::Options options;
 		options.verbose = false;
-		pm.options = options;
-		pm.Solve();
+		this->pm->options = options;
+		this->pm->Solve();
 		this->reset();
-		for (unsigned int i = 0; i < this->vertices.size(); i++) {
-			unsigned int j = pm.GetMatch(i);
+		for (unsigned int i = 0; i < nNodes; i++) {
+			unsigned int j = this->pm->GetMatch(i);
 			if (i < j) {
-				auto u = this->vertices[i];
-				auto v = this->vertices[j];
-				if (!this->duplicateInstance || (u->mirror != v && i % 2 == 0)) {
-					this->matches.push_back({ u,v });
+				if (!this->duplicateInstance) {
+					this->matches.push_back({ this->vertices[i], this->vertices[j] });
+				} else if (i % 2 == 0 && j != i + 1) {
+					/* Both are original vertices, since edges between an original
+					 * and a mirror vertex only exist between the two copies */
+					this->matches.push_back({ this->vertices[i / 2], this->vertices[j / 2] });
 				}
 			}
 		}
@@ -83,6 +134,20 @@ namespace maxmatching {
 		return ret;
 	}
 
+	/* Reads the mates from the Blossom V instance. In a duplicated instance,
+	 * an original vertex matched to its own mirror is unmatched. */
+	template <class Label>
+	void BlossomVSolver<Label>::getMatchingMates(unsigned int* mates) {
+		for (unsigned int i = 0; i < this->vertices.size(); i++) {
+			if (!this->duplicateInstance) {
+				mates[i] = this->pm->GetMatch(i);
+			} else {
+				unsigned int j = this->pm->GetMatch(2 * i);
+				mates[i] = j != 2 * i + 1 ? j / 2 : NoMate;
+			}
+		}
+	}
+
 	template <class Label>
 	void BlossomVSolver<Label>::reset() {
 		this->matches.clear();
@@ -93,6 +158,8 @@ namespace maxmatching {
 		this->reset();
 		this->edges.clear();
 		this->edgeWeights.clear();
+		delete(this->pm);
+		this->pm = nullptr;
 		while (!this->vertices.empty()) {
 			BlossomVertex<Label>* v = this->vertices.back();
 			this->vertices.pop_back();
@@ -9,8 +9,6 @@ namespace maxmatching {
 		static unsigned int idCtr;
 		static unsigned int nextId();
 	public:
-		BlossomVertex* mirror;
-
 		BlossomVertex(Label l);
 		~BlossomVertex();
 
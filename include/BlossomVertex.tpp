@@ -2,7 +2,7 @@
 
 namespace maxmatching {
 	template <class Label>
-	BlossomVertex<Label>::BlossomVertex(Label l) : BaseVertex<Label>(BlossomVertex<Label>::nextId(), l), mirror(nullptr) {}
+	BlossomVertex<Label>::BlossomVertex(Label l) : BaseVertex<Label>(BlossomVertex<Label>::nextId(), l) {}
 
 	template <class Label>
 	BlossomVertex<Label>::~BlossomVertex() {}
@@ -5,7 +5,7 @@ namespace maxmatching {
 	class CherryBlossom;
 }
 
-#include <functional>
+#include <utility>
 #include "Statistics.h"
 #include "Debug.h"
 #include "List.h"
@@ -18,7 +18,8 @@ namespace maxmatching {
 	private:
 		/* Receptacle of the cherry blossom */
 		Vertex<Label>* receptacle;
-		/* List of vertices in the corolla */
+		/* List of vertices in the corolla. Merging moves the vertices of the child to the
+		 * representant, so only the list of the representant is in use. */
 		List<Vertex<Label>> vertices;
 		/* Parent in the disjoint-set data structure */
 		CherryBlossom<Label>* parentBlossom;
@@ -27,7 +28,7 @@ namespace maxmatching {
 		/* Level of this blossom */
 		int level;
 	public:
-		/* List of children in the disjoint-set data structure */
+		/* List of children in the disjoint-set data structure, which owns them */
 		List<CherryBlossom<Label>> childBlossoms;
 		/* ListElement for the children lists in the disjoint-set data structure
 		 * Necessary for O(1) deletion */
@@ -44,7 +45,9 @@ namespace maxmatching {
 		void rotate(Vertex<Label>* newReceptacle);
 		void setReceptacle(Vertex<Label>* newReceptacle);
 		Vertex<Label>* getReceptacle();
-		void foreachVertex(std::function<void(Vertex<Label>*)> fun);
+		ListElement<Vertex<Label>>* getFirstVertex();
+		template <class F>
+		void foreachVertex(F fun);
 		void merge(CherryBlossom<Label>* child);
 		void remove(CherryBlossom<Label>* child);
 		CherryBlossom<Label>* getReference();
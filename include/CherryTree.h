@@ -7,6 +7,7 @@ namespace maxmatching {
 
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <functional>
 #include "Statistics.h"
 #include "Debug.h"
@@ -17,16 +18,61 @@ namespace maxmatching {
 	template <class Label>
 	class CherryTree {
 	private:
-		/* Counter to enumerate debug prints */
-		static int printCtr;
 		/* Internal debug method */
 		void recursivePrintNode(Vertex<Label>* v, const std::string& prefix, std::stringstream& stream);
-		/* Adopts a blossom with a receptacle, that has just been added to the tree */
-		void adoptBlossom(CherryBlossom<Label>* blossom);
+		/* Steps of the worklist in add. Adding a vertex adopts the blossoms borne by its new
+		 * partner, adds its old children and then its old parent. Adopting a blossom claims
+		 * its corolla, adopts the blossoms borne by the corolla and adds their children.
+		 * The Done steps continue a loop after the nested frame has been finished. */
+		enum AddStep {
+			AddVertex,
+			AddBorneBlossom,
+			AddBorneBlossomDone,
+			AddOldChild,
+			AddOldChildDone,
+			AddOldParent,
+			AdoptBlossom,
+			AdoptVertex,
+			AdoptBorneBlossom,
+			AdoptBorneBlossomDone,
+			AdoptChild,
+			AdoptChildDone
+		};
+		/* Frame of the worklist in add, replacing a recursive call */
+		struct AddFrame {
+			AddStep step;
+			/* Even parent and added vertex */
+			Vertex<Label>* parent;
+			Vertex<Label>* vertex;
+			/* Adopted blossom */
+			CherryBlossom<Label>* blossom;
+			/* Positions of the loops over the corolla, the borne blossoms and the odd children */
+			ListElement<Vertex<Label>>* vertexEl;
+			ListElement<CherryBlossom<Label>>* blossomEl;
+			ListElement<Vertex<Label>>* childEl;
+
+			AddFrame(AddStep step, Vertex<Label>* parent, Vertex<Label>* vertex, CherryBlossom<Label>* blossom)
+				: step(step)
+				, parent(parent)
+				, vertex(vertex)
+				, blossom(blossom)
+				, vertexEl(nullptr)
+				, blossomEl(nullptr)
+				, childEl(nullptr) {}
+		};
+		/* Capacity of the scratch space at the start of every run */
+		static const unsigned int SCRATCH_SIZE = 1 << 12;
+		/* Worklist of add and the vertices of remove and updateLevelBelow, shared by all
+		 * trees, so deep trees neither overflow the call stack nor allocate per call */
+		static std::vector<AddFrame> addStack;
+		static std::vector<Vertex<Label>*> vertexStack;
 		/* Internal debug flag.
 		 * Printing a tree, while the structure is being reformed is unsafe. */
 		bool consistent;
 	public:
+		/* Frees the scratch space grown by the last run and reserves the initial capacity.
+		 * Called before the measure starts, so every run is charged the same. */
+		static void resetScratch();
 		/* Root of the tree */
 		Vertex<Label>* root;
 		/* Number of vertices in the tree */
@@ -45,7 +91,6 @@ namespace maxmatching {
 		List<Vertex<Label>>* getVertices();
 
 		void logTree();
-		void printTree();
 	};
 }
 
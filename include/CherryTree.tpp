@@ -1,6 +1,19 @@
 #include "CherryTree.h"
 
 namespace maxmatching {
+	template <class Label>
+	std::vector<typename CherryTree<Label>::AddFrame> CherryTree<Label>::addStack;
+	template <class Label>
+	std::vector<Vertex<Label>*> CherryTree<Label>::vertexStack;
+
+	template <class Label>
+	void CherryTree<Label>::resetScratch() {
+		std::vector<AddFrame>().swap(CherryTree<Label>::addStack);
+		std::vector<Vertex<Label>*>().swap(CherryTree<Label>::vertexStack);
+		CherryTree<Label>::addStack.reserve(CherryTree<Label>::SCRATCH_SIZE);
+		CherryTree<Label>::vertexStack.reserve(CherryTree<Label>::SCRATCH_SIZE);
+	}
+
 	template <class Label>
 	CherryTree<Label>::CherryTree(Vertex<Label>* root)
 		: consistent(true)
@@ -10,11 +23,9 @@ namespace maxmatching {
 		Statistics::incrementTreeCreated();
 	}
 
-
 	template <class Label>
 	CherryTree<Label>::~CherryTree() {
 		DEBUG("Deleting tree " << (this->root == nullptr ? 0 : this->root->id) << "\n");
-		this->printTree();
 		/* Prevent any prints during deletion */
 		consistent = false;
 		/* Remove all vertices from the tree, so the vertices can't reference the tree anymore. */
@@ -31,6 +42,7 @@ namespace maxmatching {
 	template <class Label>
 	void CherryTree<Label>::rotate(Vertex<Label>* newRoot) {
 		DEBUG("Rotating tree " << this->root->id << " to " << newRoot->id << "\n");
+		TRACE_EVENT(EventRotate, this->root->id, newRoot->id);
 		bool consistencyUpdate = this->consistent;
 		consistent = false;
 		List<Vertex<Label>> * l = new List<Vertex<Label>>();
@@ -96,104 +108,174 @@ namespace maxmatching {
 		 * be commented back in! */
 		 //this->updateLevel();
 		consistent = consistencyUpdate;
-		this->printTree();
-	}
-
-	/* This is to be called, if the receptacle has just been added and the other vertices
-	 * of the corolla are in no tree yet. It claims the corolla for this tree and manages
-	 * the children of the new nodes. */
-	template <class Label>
-	void CherryTree<Label>::adoptBlossom(CherryBlossom<Label>* blossom) {
-		DEBUG("Adopting blossom " << blossom->getReceptacle()->id << "\n");
-		bool consistencyUpdate = this->consistent;
-		this->consistent = false;
-		auto fun = [this, blossom](Vertex<Label> * v)->void {
-			DEBUG("Visiting " << v->id << "\n");
-			v->setContainingTree(this);
-			v->enqueue();
-			this->size += 1;
-			/* Adopt further blossoms */
-			for (auto el = v->bearingBlossoms.getFirstElement(); el != nullptr; el = el->nxtElem) {
-				this->adoptBlossom(el->value->getReference());
-			}
-			/* Add children to the tree */
-			for (auto elem = v->oddChildren.getFirstElement(); elem != nullptr; elem = elem->nxtElem) {
-				Vertex<Label>* child = elem->value;
-				if (child->getContainingBlossom() != blossom) {
-					this->add(v, child);
-				}
-			}
-		};
-		blossom->updateLevel();
-		blossom->foreachVertex(fun);
-		this->consistent = consistencyUpdate;
 	}
 
 	/* Adds a vertex into the tree with the given parent node as even parent.
 	 * Also uses as much of potential old tree structure as possible
-	 * given the information stored in the vertices. */
+	 * given the information stored in the vertices.
+	 * Instead of calling itself for the old children and parents and for adopted
+	 * blossoms, it works on a stack of frames, which continue their loops in the
+	 * same order as the recursive calls did. */
 	template <class Label>
 	void CherryTree<Label>::add(Vertex<Label> * parent, Vertex<Label> * newVertex) {
-		/* Sanity check */
-		if (newVertex->getContainingTree() != nullptr) {
-			return;
-		}
 		bool consistencyUpdate = this->consistent;
 		this->consistent = false;
-		/* Update references for containment in tree */
-		Vertex<Label>* newPartner = newVertex->getMatchingPartner();
-		DEBUG("Adding vertices "
-			<< parent->id << " -> "
-			<< newVertex->id << " -> "
-			<< newPartner->id << "\n");
-		newVertex->setEvenParent(parent);
-		newVertex->setContainingTree(this);
-		newPartner->setContainingTree(this);
-		newPartner->enqueue();
-		this->size += 2;
-		/* Remove all odd children of the new node, since odd and non-even nodes can't have odd children */
-		while (!newVertex->oddChildren.isEmpty()) {
-			ListElement<Vertex<Label>>* elem = newVertex->oddChildren.popElem();
-			elem->value->setEvenParent(nullptr);
-		}
-		/* If this gets added, the old blossom should be dead for consistency reasons */
-		if (newVertex->getContainingBlossom() != nullptr) {
-			delete(newVertex->getContainingBlossom());
-		}
-		/* Delete potentially borne blossoms by now odd and non-even node */
-		while (!newVertex->bearingBlossoms.isEmpty()) {
-			delete(newVertex->bearingBlossoms.popElem()->value);
-		}
-		/* Adopt blossoms borne by the matching partner, which is even in this tree */
-		for (auto el = newPartner->bearingBlossoms.getFirstElement(); el != nullptr; el = el->nxtElem) {
-			this->adoptBlossom(el->value->getReference());
-		}
-		/* Call recursive, if this Vertex<Label> was hosting an old twig */
-		DEBUG("Node " << newPartner->id << " has " << newPartner->oddChildren.getSize() << " odd children\n");
-		for (auto elem = newPartner->oddChildren.getFirstElement(); elem != nullptr; elem = elem->nxtElem) {
-			Vertex<Label>* child = elem->value;
-			DEBUG("Node " << newPartner->id << " considers child " << child->id << "\n");
-			CherryBlossom<Label> * childBlossom = child->getContainingBlossom();
-			if (childBlossom == nullptr || childBlossom->getReceptacle() != newPartner) {
-				/* Otherwise this should've been handled by adopting the blossom */
-				this->add(newPartner, child);
-			} else {
-				DEBUG("Node " << newPartner->id << " ignores child " << child->id << "\n");
+		std::vector<AddFrame>& stack = CherryTree<Label>::addStack;
+		unsigned long base = stack.size();
+		stack.push_back(AddFrame(AddVertex, parent, newVertex, nullptr));
+		while (stack.size() > base) {
+			/* Invalidated by pushing new frames */
+			AddFrame& frame = stack.back();
+			switch (frame.step) {
+			case AddVertex: {
+				Vertex<Label>* newVertex = frame.vertex;
+				/* Sanity check */
+				if (newVertex->getContainingTree() != nullptr) {
+					stack.pop_back();
+					break;
+				}
+				TRACE_EVENT(EventGrow, frame.parent->id, newVertex->id);
+				/* Update references for containment in tree */
+				Vertex<Label>* newPartner = newVertex->getMatchingPartner();
+				DEBUG("Adding vertices "
+					<< frame.parent->id << " -> "
+					<< newVertex->id << " -> "
+					<< newPartner->id << "\n");
+				newVertex->setEvenParent(frame.parent);
+				newVertex->setContainingTree(this);
+				newPartner->setContainingTree(this);
+				newPartner->enqueue();
+				this->size += 2;
+				/* Remove all odd children of the new node, since odd and non-even nodes can't have odd children */
+				while (!newVertex->oddChildren.isEmpty()) {
+					ListElement<Vertex<Label>>* elem = newVertex->oddChildren.popElem();
+					elem->value->setEvenParent(nullptr);
+				}
+				/* If this gets added, the old blossom should be dead for consistency reasons */
+				if (newVertex->getContainingBlossom() != nullptr) {
+					delete(newVertex->getContainingBlossom());
+				}
+				/* Delete potentially borne blossoms by now odd and non-even node */
+				while (!newVertex->bearingBlossoms.isEmpty()) {
+					delete(newVertex->bearingBlossoms.popElem()->value);
+				}
+				frame.blossomEl = newPartner->bearingBlossoms.getFirstElement();
+				frame.step = AddBorneBlossom;
+				break;
 			}
-		}
-		/* Safe upwards in the trees */
-		Vertex<Label>* oldParent = newPartner->getEvenParent();
-		if (oldParent != nullptr) {
-			newPartner->setEvenParent(nullptr);
-			if (oldParent->getContainingTree() != newPartner->getContainingTree()) {
-				this->add(newPartner, oldParent);
+			case AddBorneBlossom:
+				/* Adopt blossoms borne by the matching partner, which is even in this tree */
+				if (frame.blossomEl != nullptr) {
+					frame.step = AddBorneBlossomDone;
+					stack.push_back(AddFrame(AdoptBlossom, nullptr, nullptr, frame.blossomEl->value->getReference()));
+				} else {
+					Vertex<Label>* newPartner = frame.vertex->getMatchingPartner();
+					DEBUG("Node " << newPartner->id << " has " << newPartner->oddChildren.getSize() << " odd children\n");
+					frame.childEl = newPartner->oddChildren.getFirstElement();
+					frame.step = AddOldChild;
+				}
+				break;
+			case AddBorneBlossomDone:
+				frame.blossomEl = frame.blossomEl->nxtElem;
+				frame.step = AddBorneBlossom;
+				break;
+			case AddOldChild: {
+				/* Continue with the children, if this Vertex<Label> was hosting an old twig */
+				if (frame.childEl == nullptr) {
+					frame.step = AddOldParent;
+					break;
+				}
+				Vertex<Label>* newPartner = frame.vertex->getMatchingPartner();
+				Vertex<Label>* child = frame.childEl->value;
+				DEBUG("Node " << newPartner->id << " considers child " << child->id << "\n");
+				CherryBlossom<Label> * childBlossom = child->getContainingBlossom();
+				if (childBlossom == nullptr || childBlossom->getReceptacle() != newPartner) {
+					/* Otherwise this should've been handled by adopting the blossom */
+					frame.step = AddOldChildDone;
+					stack.push_back(AddFrame(AddVertex, newPartner, child, nullptr));
+				} else {
+					DEBUG("Node " << newPartner->id << " ignores child " << child->id << "\n");
+					frame.childEl = frame.childEl->nxtElem;
+				}
+				break;
+			}
+			case AddOldChildDone:
+				frame.childEl = frame.childEl->nxtElem;
+				frame.step = AddOldChild;
+				break;
+			case AddOldParent: {
+				/* Safe upwards in the trees */
+				Vertex<Label>* newPartner = frame.vertex->getMatchingPartner();
+				Vertex<Label>* oldParent = newPartner->getEvenParent();
+				/* This is the last step of the frame, so the old parent takes its place */
+				stack.pop_back();
+				if (oldParent != nullptr) {
+					newPartner->setEvenParent(nullptr);
+					if (oldParent->getContainingTree() != newPartner->getContainingTree()) {
+						stack.push_back(AddFrame(AddVertex, newPartner, oldParent, nullptr));
+					}
+					/* Creating blossoms between two even nodes is dangerous
+					 * while the tree is inconsistent!
+					 * If anyone ever intends to do so, beware of hard bugs to catch. */
+				}
+				break;
+			}
+			case AdoptBlossom:
+				/* The receptacle has just been added and the other vertices of the corolla
+				 * are in no tree yet. Claim the corolla for this tree and manage the children
+				 * of the new nodes. */
+				DEBUG("Adopting blossom " << frame.blossom->getReceptacle()->id << "\n");
+				frame.blossom->updateLevel();
+				frame.vertexEl = frame.blossom->getFirstVertex();
+				frame.step = AdoptVertex;
+				break;
+			case AdoptVertex: {
+				if (frame.vertexEl == nullptr) {
+					stack.pop_back();
+					break;
+				}
+				Vertex<Label>* v = frame.vertexEl->value;
+				DEBUG("Visiting " << v->id << "\n");
+				v->setContainingTree(this);
+				v->enqueue();
+				this->size += 1;
+				frame.blossomEl = v->bearingBlossoms.getFirstElement();
+				frame.step = AdoptBorneBlossom;
+				break;
+			}
+			case AdoptBorneBlossom:
+				/* Adopt further blossoms */
+				if (frame.blossomEl != nullptr) {
+					frame.step = AdoptBorneBlossomDone;
+					stack.push_back(AddFrame(AdoptBlossom, nullptr, nullptr, frame.blossomEl->value->getReference()));
+				} else {
+					frame.childEl = frame.vertexEl->value->oddChildren.getFirstElement();
+					frame.step = AdoptChild;
+				}
+				break;
+			case AdoptBorneBlossomDone:
+				frame.blossomEl = frame.blossomEl->nxtElem;
+				frame.step = AdoptBorneBlossom;
+				break;
+			case AdoptChild:
+				/* Add children to the tree */
+				if (frame.childEl == nullptr) {
+					frame.vertexEl = frame.vertexEl->nxtElem;
+					frame.step = AdoptVertex;
+				} else if (frame.childEl->value->getContainingBlossom() != frame.blossom) {
+					frame.step = AdoptChildDone;
+					stack.push_back(AddFrame(AddVertex, frame.vertexEl->value, frame.childEl->value, nullptr));
+				} else {
+					frame.childEl = frame.childEl->nxtElem;
+				}
+				break;
+			case AdoptChildDone:
+				frame.childEl = frame.childEl->nxtElem;
+				frame.step = AdoptChild;
+				break;
 			}
-			/* Creating blossoms between two even nodes is dangerous
-			 * while the tree is inconsistent!
-			 * If anyone ever intends to do so, beware of hard bugs to catch. */
 		}
 		this->consistent = consistencyUpdate;
-		this->printTree();
 	}
 
 	/* Removes a vertex from the tree. Also removes all vertices hanging below
@@ -203,7 +285,15 @@ namespace maxmatching {
 	void CherryTree<Label>::remove(Vertex<Label> * v) {
 		bool consistencyUpdate = this->consistent;
 		this->consistent = false;
-		if (v->getContainingTree() == this) {
+		std::vector<Vertex<Label>*>& stack = CherryTree<Label>::vertexStack;
+		unsigned long base = stack.size();
+		stack.push_back(v);
+		while (stack.size() > base) {
+			v = stack.back();
+			stack.pop_back();
+			if (v->getContainingTree() != this) {
+				continue;
+			}
 			v->setContainingTree(nullptr);
 			if (v == this->root) {
 				this->root = nullptr;
@@ -211,10 +301,10 @@ namespace maxmatching {
 			Vertex<Label>* m = v->getMatchingPartner();
 			this->size--;
 			if (m != nullptr) {
-				this->remove(m);
+				stack.push_back(m);
 			}
 			for (auto el = v->oddChildren.getFirstElement(); el != nullptr; el = el->nxtElem) {
-				this->remove(el->value);
+				stack.push_back(el->value);
 			}
 		}
 		this->consistent = consistencyUpdate;
@@ -239,7 +329,7 @@ namespace maxmatching {
 		} else if (wBlossom != nullptr && wBlossom->getReceptacle() == u) {
 			return;
 		}
-		this->printTree();
+		TRACE_EVENT(EventBlossom, u->id, w->id);
 		bool consistencyUpdate = this->consistent;
 		this->consistent = false;
 		/* Using the level of the vertices, the search for a common even
@@ -371,7 +461,6 @@ namespace maxmatching {
 			w->setEvenParent(u);
 		}
 		this->consistent = consistencyUpdate;
-		this->printTree();
 	}
 
 	/* Updates the level of all vertices */
@@ -380,20 +469,20 @@ namespace maxmatching {
 		this->updateLevelBelow(this->root);
 	}
 
-	/* Updates the level of all vertices below the given vertex */
+	/* Updates the level of all vertices below the given vertex in breadth-first order */
 	template <class Label>
 	void CherryTree<Label>::updateLevelBelow(Vertex<Label> * v) {
-		List<Vertex<Label>>* remainingVertices = new List<Vertex<Label>>();
-		remainingVertices->push(v);
-		while (!remainingVertices->isEmpty()) {
-			Vertex<Label>* w = remainingVertices->pop();
+		std::vector<Vertex<Label>*>& queue = CherryTree<Label>::vertexStack;
+		unsigned long base = queue.size();
+		queue.push_back(v);
+		for (unsigned long i = base; i < queue.size(); i++) {
+			Vertex<Label>* w = queue[i];
 			w->updateLevel();
 			for (auto childEl = w->oddChildren.getFirstElement(); childEl != nullptr; childEl = childEl->nxtElem) {
-				Vertex<Label>* m = childEl->value->getMatchingPartner();
-				remainingVertices->append(m);
+				queue.push_back(childEl->value->getMatchingPartner());
 			}
 		}
-		remainingVertices->deleteStructure();
+		queue.resize(base);
 	}
 
 	template <class Label>
@@ -418,9 +507,6 @@ namespace maxmatching {
 	}
 
 
-	template <class Label>
-	int CherryTree<Label>::printCtr = 0;
-
 	template <class Label>
 	void CherryTree<Label>::logTree() {
 		std::stringstream stream;
@@ -429,61 +515,6 @@ namespace maxmatching {
 		DEBUG(buffer);
 	}
 
-	/* Prints the tree for debugging purposes. This is disabled if not using debugging. */
-	template <class Label>
-	void CherryTree<Label>::printTree() {
-#ifndef DEBUG_F
-		return;
-#endif
-		if (!this->consistent) {
-			return;
-		}
-		DEBUG("@Tree(" << (this->root == nullptr ? 0 : this->root->id) << ") ");
-		std::stringstream gmlStream, dotStream;
-		gmlStream << "graph [\n";
-		dotStream << "digraph G {\n";
-		auto vs = this->getVertices();
-		for (auto it = vs->getFirstElement(); it != nullptr; it = it->nxtElem) {
-			Vertex<Label>* v = it->value;
-			gmlStream << "\tnode [\n\t\tid " << v->id << "\n\t\tlabel \"" << v->id << "\"\n\t]\n";
-		}
-		for (auto it = vs->getFirstElement(); it != nullptr; it = it->nxtElem) {
-			Vertex<Label>* v = it->value;
-			Vertex<Label>* m = v->getMatchingPartner();
-			Vertex<Label>* p = v->getEvenParent();
-			if (m != nullptr) {
-				gmlStream << "\tedge [\n\t\tsource " << v->id << "\n\t\ttarget " << m->id << "\n\t\tlabel \"m\"\n\t]\n";
-				dotStream << "\t" << v->id << " -> " << m->id << "[color=red,penwidth=2.0];\n";
-			}
-			if (p != nullptr) {
-				gmlStream << "\tedge [\n\t\tsource " << p->id << "\n\t\ttarget " << v->id << "\n\t]\n";
-				dotStream << "\t" << p->id << " -> " << v->id << ";\n";
-			}
-			//for(auto el = v->oddChildren.getFirstElement(); el != nullptr; el = el->nxtElem) {
-				//dotStream << "\t" << v->id << " -> " << el->value->id << "[color=blue,penwidth=0.5];\n";
-			//}
-		}
-		gmlStream << "]\n";
-		dotStream << "}\n";
-		std::string gmlBuffer = gmlStream.str(), dotBuffer = dotStream.str();
-		std::ofstream gmlWriter, dotWriter;
-		std::stringstream gmlFileNameBuilder, dotFileNameBuilder;
-		gmlFileNameBuilder << "debug/graphs/" << printCtr << ".gml";
-		dotFileNameBuilder << "debug/graphs/" << printCtr << ".dot";
-		gmlWriter.open(gmlFileNameBuilder.str());
-		dotWriter.open(dotFileNameBuilder.str());
-		if (!gmlWriter.fail() && !dotWriter.fail()) {
-			gmlWriter << gmlBuffer;
-			dotWriter << dotBuffer;
-			DEBUG("Printed image " << printCtr++ << " to files " << gmlFileNameBuilder.str() << " and " << dotFileNameBuilder.str() << "\n");
-		} else {
-			DEBUG("Failed to print image " << printCtr++ << " to files " << gmlFileNameBuilder.str() << " and " << dotFileNameBuilder.str() << "\n");
-		}
-		vs->deleteStructure();
-		gmlWriter.close();
-		dotWriter.close();
-	}
-
 	template <class Label>
 	void CherryTree<Label>::recursivePrintNode(Vertex<Label> * v, const std::string & prefix, std::stringstream & stream) {
 		stream << prefix.c_str() << "-> " << v->id;
@@ -1,13 +1,16 @@
 #pragma once
 #include <iostream>
+#include "EventTrace.h"
 
 /* Debug flag. Comment in or out to produce debug messages on std::cout.
  * Bewar: Debug messages are a lot. On big instances, this will result in
  * gigabytes of debug messages! */
 //#define DEBUG_F
 
+/* Defined in Debug.cpp */
+extern bool DEBUG_ENABLED;
+
 #ifdef DEBUG_F
-bool DEBUG_ENABLED = true;
 #define TOGGLE_DEBUG()\
 /**/DEBUG_ENABLED = !DEBUG_ENABLED;
 #define DEBUG(PRINT)\
@@ -16,7 +19,6 @@ bool DEBUG_ENABLED = true;
 /**/	std::flush(std::cout);\
 /**/}
 #else
-bool DEBUG_ENABLED = false;
 #define TOGGLE_DEBUG()
 #define DEBUG(print)
 #endif
\ No newline at end of file
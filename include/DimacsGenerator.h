@@ -1,5 +1,8 @@
 #pragma once
+#include <functional>
+#include <vector>
 #include "SimpleGraph.h"
+#include "Tools.h"
 
 /* Adopted from http://archive.dimacs.rutgers.edu/pub/netflow/generators/matching/random.c */
 
@@ -8,53 +11,35 @@
 /*  Challenge format.  Instances have random uniform edge          */
 /*  costs.                                                         */
 /*  C. McGeoch at DIMACS, July 1991  */
-
-/*  You may need to insert your own random number generators.     */
-/*     double drand48();  returns doubles from (0.0, 1.0]         */
-/*     void srand48(seed);  initializes RNG with seed             */
-/*     long seed;                                                 */
-
-/*  Example input:         */
-/*  nodes 1000             */
-/*  edges  2500            */
-/*  maxcost 1000           */
-/*  seed  818182717        */
-
-/*  Seed command is optional.                           */
-/*  nodes  N  : specifies N nodes                       */
-/*  edges  A  : specifies A edges                       */
-/*  maxcost X : specifies maximum edge weight           */
-/*  seed   S  : RNG seed; default system timer          */
 /*------------------------------------------------------*/
 
-#define MAXNODES 10000
-#define MAXCOST 100000
-
 namespace maxmatching {
+	/* Samples a uniform random graph with exactly m edges (G(n,m)) like the DIMACS generator.
+	 * Instead of rejecting duplicate edges with a search tree, the vertex pairs (u,v), u > v,
+	 * are numbered row by row and the rows are split into blocks of about EDGES_PER_BLOCK
+	 * expected edges. The number of edges of every block is drawn from a hypergeometric
+	 * distribution drawn from stream 0 of the seed, then block b samples its edges from stream
+	 * b + 1. Blocks are sampled in parallel by GGenerator::addEdgeBlocks, so the graph only
+	 * depends on the seed, not on the number of threads. */
 	class DimacsGenerator {
 	private:
-		/* BST for Set searches */
-		typedef struct node_type {
-			unsigned long val;
-			struct node_type* left;
-			struct node_type* right;
-		} treenode;
-
-		unsigned long arc_size;
-		treenode* root;
-
-		unsigned long rand_long(unsigned long max, std::mt19937_64& rgen);
-		double rand_d(std::mt19937_64& rgen);
-		void insert(unsigned long arc);
-		bool inset(unsigned long arc);
-
-		void generateEdgesSparse(SimpleGraph<unsigned int>* graph, unsigned long nEdges, std::mt19937_64& rgen);
-		void generateEdgesDense(SimpleGraph<unsigned int>* graph, unsigned long nEdges, std::mt19937_64& rgen);
+		static const unsigned long EDGES_PER_BLOCK = 1 << 20;
+
+		/* Rows [firstRow, endRow) with all pairs (u,v), firstRow <= u < endRow, v < u */
+		struct Block {
+			unsigned long firstRow;
+			unsigned long endRow;
+			unsigned long nEdges;
+		};
+
+		static unsigned long sampleHypergeometric(unsigned long population, unsigned long successes, unsigned long draws, RandomStream& rgen);
+		static void sampleSorted(unsigned long size, unsigned long k, RandomStream& rgen, std::vector<unsigned long>& ret);
+		static void forEachEdge(const Block& block, RandomStream rgen, const std::function<void(unsigned int, unsigned int)>& func);
 	public:
-		inline DimacsGenerator() : arc_size(0), root(NULL) {}
+		DimacsGenerator();
 		~DimacsGenerator();
 
-		SimpleGraph<unsigned int>* generate(unsigned long nPoints, unsigned long nEdges, std::mt19937_64& rgen);
+		SimpleGraph<unsigned int>* generate(unsigned long nPoints, unsigned long nEdges, unsigned long seed);
 	};
 
 }
@@ -3,12 +3,11 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include "Solver.h"
 #include "EdmondsVertex.h"
-#include <map>
+#include "SolverEnums.h"
 #include <vector>
 #include <iostream>
 #include "boost/property_map/property_map.hpp"
 #include "boost/graph/adjacency_list.hpp"
-#include "boost/graph/labeled_graph.hpp"
 #include "boost/graph/max_cardinality_matching.hpp"
 #include "boost/graph/iteration_macros.hpp"
 
@@ -17,33 +16,46 @@ namespace maxmatching {
 	template <class Label>
 	class EdmondsBoostSolver : public Solver<EdmondsVertex<Label>, Label> {
 
-		typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> AdjList;
-		typedef boost::labeled_graph<AdjList, EdmondsVertex<Label>*, boost::mapS> Graph;
+		typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
 		typedef typename boost::graph_traits<Graph>::vertex_descriptor VHandle;
-		typedef std::map<VHandle, VHandle> MateMap;
-		typedef boost::associative_property_map<MateMap> MateMapW;
+		typedef std::vector<VHandle> MateMap;
 
 	private:
-		/* List of all vertices. */
+		/* List of all vertices. The position of a vertex is its vertex descriptor in boost. */
 		std::vector<EdmondsVertex<Label>*> vertices;
-		/* Map to create the matching list from the solution provided by boost */
-		std::map<VHandle, EdmondsVertex<Label>*> invertedVMap;
+		/* Id of the first vertex. Vertices of one solver are created consecutively,
+		 * so the descriptor of a vertex is its id minus this id. */
+		unsigned int firstId;
 		/* The graph representation used by boost */
 		Graph graph;
-		/* Buffer object to store the boost solution */
+		/* Buffer object to store the boost solution, indexed by vertex descriptor */
 		MateMap mateMap;
+		/* Heuristic for the initial matching */
+		BoostInitialMatching initialMatching;
+		/* If set, boost verifies the maximality of the matching afterwards */
+		bool verify;
+
+		VHandle getHandle(EdmondsVertex<Label>* v);
+		template <template <typename, typename> class InitialMatchingFinder>
+		bool runMatching();
+		template <template <typename, typename> class InitialMatchingFinder, template <typename, typename, typename> class MatchingVerifier>
+		bool runMatching();
 	public:
 		EdmondsBoostSolver();
+		/* The first argument selects the initial matching (see BoostInitialMatching),
+		 * a second argument != 0 disables the verifier. */
 		inline EdmondsBoostSolver(unsigned int arg1, unsigned int arg2) : EdmondsBoostSolver() {
-			(void)arg1;
-			(void)arg2;
+			this->initialMatching = (BoostInitialMatching)arg1;
+			this->verify = arg2 == 0;
 		};
 		~EdmondsBoostSolver();
 
+		void readGraph(SimpleGraph<Label>* g);
 		void addVertex(EdmondsVertex<Label>* v);
 		void addEdge(EdmondsVertex<Label>* u, EdmondsVertex<Label>* v);
 		void calculateMaxMatching();
 		std::vector<EdmondsVertex<Label>*>* getMatchingRepresentatives();
+		void getMatchingMates(unsigned int* mates);
 		std::vector<std::pair<Label, Label>>* getMatchingLabels();
 		void reset();
 		void clearVertices();
@@ -4,56 +4,127 @@ namespace maxmatching {
 	template <class Label>
 	EdmondsBoostSolver<Label>::EdmondsBoostSolver()
 		: vertices()
-		, invertedVMap()
+		, firstId(0)
 		, graph()
-		, mateMap() {}
+		, mateMap()
+		, initialMatching(ExtraGreedyInitialMatching)
+		, verify(true) {}
 
 
 	template <class Label>
 	EdmondsBoostSolver<Label>::~EdmondsBoostSolver() {}
 
 
+	template <class Label>
+	typename EdmondsBoostSolver<Label>::VHandle EdmondsBoostSolver<Label>::getHandle(EdmondsVertex<Label>* v) {
+		return v->id - this->firstId;
+	}
+
+	/* Builds the boost graph in bulk from an edge list instead of adding every
+	 * edge separately. Vertices and edges are created in the same order as by
+	 * the generic implementation. */
+	template <class Label>
+	void EdmondsBoostSolver<Label>::readGraph(SimpleGraph<Label>* g) {
+		unsigned int n = g->getVertexCount();
+		/* Maps the index in the simple graph to the descriptor in boost */
+		std::vector<unsigned int> handles(n);
+		this->vertices.reserve(this->vertices.size() + n);
+		for (auto vIndex : g->order) {
+			auto vLabel = g->vertexLabel[vIndex];
+			auto v = new EdmondsVertex<Label>(vLabel);
+			if (this->vertices.empty()) {
+				this->firstId = v->id;
+			}
+			handles[vIndex] = this->getHandle(v);
+			this->vertices.push_back(v);
+		}
+		std::vector<std::pair<unsigned int, unsigned int>> edges;
+		edges.reserve(g->getEdgeCount());
+		for (auto vIndex : g->order) {
+			auto vHandle = handles[vIndex];
+			auto adjList = g->adjacencies[vIndex];
+			for (auto it2 = adjList->begin(); it2 != adjList->end(); it2++) {
+				auto wHandle = handles[*it2];
+				if (vHandle < wHandle) {
+					edges.push_back({ vHandle, wHandle });
+				}
+			}
+		}
+		this->graph = Graph(edges.begin(), edges.end(), this->vertices.size());
+	}
+
 	template <class Label>
 	void EdmondsBoostSolver<Label>::addVertex(EdmondsVertex<Label>* v) {
-		auto descriptor = this->graph.add_vertex(v);
-		this->invertedVMap[descriptor] = v;
+		if (this->vertices.empty()) {
+			this->firstId = v->id;
+		}
+		boost::add_vertex(this->graph);
 		this->vertices.push_back(v);
 	}
 
 	template <class Label>
 	void EdmondsBoostSolver<Label>::addEdge(EdmondsVertex<Label>* u, EdmondsVertex<Label>* v) {
-		boost::add_edge_by_label(u, v, this->graph);
+		boost::add_edge(this->getHandle(u), this->getHandle(v), this->graph);
 	}
 
 	template <class Label>
 	void EdmondsBoostSolver<Label>::calculateMaxMatching() {
-		auto mateMapWrapper = boost::associative_property_map<MateMap>(this->mateMap);
-		boost::edmonds_maximum_cardinality_matching(this->graph, mateMapWrapper);
-		/* This disables the sorting of vertices and edges before execution. It is necessary
-		 * for the gabow worst-case benchmark. Simply replace the above line by this code, if
-		 * you want to run this benchmark. */
-		 /*boost::matching<
-			 Graph,
-			 MateMapW,
-			 typename boost::property_map<Graph,boost::vertex_index_t>::type,
-			 boost::edmonds_augmenting_path_finder,
-			 boost::greedy_matching,
-			 boost::no_matching_verifier>
-			 (this->graph, mateMapWrapper, boost::get(boost::vertex_index, this->graph));*/
+		this->mateMap.assign(this->vertices.size(), boost::graph_traits<Graph>::null_vertex());
+		if (this->mateMap.empty()) {
+			return;
+		}
+		bool maximal;
+		/* Every combination of initial matching and verifier is instantiated once,
+		 * so the pipeline can be chosen at runtime. The greedy matching does not
+		 * sort the vertices by degree, which is necessary for the gabow worst-case benchmark. */
+		switch (this->initialMatching) {
+			case ExtraGreedyInitialMatching:
+				maximal = this->template runMatching<boost::extra_greedy_matching>();
+				break;
+			case GreedyInitialMatching:
+				maximal = this->template runMatching<boost::greedy_matching>();
+				break;
+			case EmptyInitialMatching:
+				maximal = this->template runMatching<boost::empty_matching>();
+				break;
+			default:
+				throw std::string("Unknown initial matching for the boost solver");
+		}
+		if (!maximal) {
+			throw std::string("The boost verifier rejected the matching");
+		}
+	}
+
+	template <class Label>
+	template <template <typename, typename> class InitialMatchingFinder>
+	bool EdmondsBoostSolver<Label>::runMatching() {
+		if (this->verify) {
+			return this->template runMatching<InitialMatchingFinder, boost::maximum_cardinality_matching_verifier>();
+		} else {
+			return this->template runMatching<InitialMatchingFinder, boost::no_matching_verifier>();
+		}
+	}
+
+	template <class Label>
+	template <template <typename, typename> class InitialMatchingFinder, template <typename, typename, typename> class MatchingVerifier>
+	bool EdmondsBoostSolver<Label>::runMatching() {
+		return boost::matching<
+			Graph,
+			VHandle*,
+			typename boost::property_map<Graph, boost::vertex_index_t>::type,
+			boost::edmonds_augmenting_path_finder,
+			InitialMatchingFinder,
+			MatchingVerifier>
+			(this->graph, &this->mateMap[0], boost::get(boost::vertex_index, this->graph));
 	}
 
 	template <class Label>
 	std::vector<EdmondsVertex<Label>*>* EdmondsBoostSolver<Label>::getMatchingRepresentatives() {
 		std::vector<EdmondsVertex<Label>*>* ret = new std::vector<EdmondsVertex<Label>*>();
-		for (auto it = this->mateMap.begin(); it != this->mateMap.end(); it++) {
-			auto vh = it->first;
-			auto mh = it->second;
-			if (mh != boost::graph_traits<Graph>::null_vertex()) {
-				auto v = this->invertedVMap[vh];
-				auto m = this->invertedVMap[mh];
-				if (v->id < m->id) {
-					ret->push_back(v);
-				}
+		for (VHandle vh = 0; vh < this->mateMap.size(); vh++) {
+			VHandle mh = this->mateMap[vh];
+			if (mh != boost::graph_traits<Graph>::null_vertex() && vh < mh) {
+				ret->push_back(this->vertices[vh]);
 			}
 		}
 		return ret;
@@ -62,36 +133,39 @@ namespace maxmatching {
 	template <class Label>
 	std::vector<std::pair<Label, Label>>* EdmondsBoostSolver<Label>::getMatchingLabels() {
 		auto ret = new std::vector<std::pair<Label, Label>>();
-		for (auto it = this->mateMap.begin(); it != this->mateMap.end(); it++) {
-			auto vh = it->first;
-			auto mh = it->second;
-			if (mh != boost::graph_traits<Graph>::null_vertex()) {
-				auto v = this->invertedVMap[vh];
-				auto m = this->invertedVMap[mh];
-				if (v->id < m->id) {
-					ret->push_back({ v->label, m->label });
-				}
+		for (VHandle vh = 0; vh < this->mateMap.size(); vh++) {
+			VHandle mh = this->mateMap[vh];
+			if (mh != boost::graph_traits<Graph>::null_vertex() && vh < mh) {
+				ret->push_back({ this->vertices[vh]->label, this->vertices[mh]->label });
 			}
 		}
 		return ret;
 	}
 
+	/* The handles are the numbers of the vertices */
+	template <class Label>
+	void EdmondsBoostSolver<Label>::getMatchingMates(unsigned int* mates) {
+		for (VHandle vh = 0; vh < this->mateMap.size(); vh++) {
+			VHandle mh = this->mateMap[vh];
+			mates[vh] = mh != boost::graph_traits<Graph>::null_vertex() ? mh : NoMate;
+		}
+	}
+
 	template <class Label>
 	void EdmondsBoostSolver<Label>::reset() {
-		mateMap = MateMap();
+		this->mateMap.clear();
 	}
 
+	/* Drops the whole graph at once instead of removing vertex by vertex,
+	 * which costs O(n) per removed vertex on vecS storage. */
 	template <class Label>
 	void EdmondsBoostSolver<Label>::clearVertices() {
-		while (!this->vertices.empty()) {
-			EdmondsVertex<Label>* v = this->vertices.back();
-			this->vertices.pop_back();
-			VHandle handle = this->graph.vertex(v);
-			boost::clear_vertex(handle, this->graph);
-			boost::remove_vertex(v, this->graph);
-			this->invertedVMap[handle] = nullptr;
+		for (EdmondsVertex<Label>* v : this->vertices) {
 			delete(v);
 		}
+		this->vertices.clear();
+		this->graph.clear();
+		this->mateMap.clear();
 	}
 
-}
\ No newline at end of file
+}
@@ -1,8 +1,8 @@
 #pragma once
-#include <map>
 #include <vector>
 #include <tuple>
-#include "lemon/list_graph.h"
+#include <memory>
+#include "lemon/smart_graph.h"
 #include "lemon/matching.h"
 #include "Solver.h"
 #include "EdmondsVertex.h"
@@ -12,18 +12,43 @@ namespace maxmatching {
 	template <class Label>
 	class EdmondsLemonSolver : public Solver<EdmondsVertex<Label>, Label> {
 	private:
-		typedef lemon::ListGraph Graph;
+		typedef lemon::SmartGraph Graph;
 		typedef lemon::MaxMatching<Graph> Matcher;
-		/* List of all vertices. */
+		/* The graph representation used by lemon together with its solver object.
+		 * Built from a simple graph, the id of a node is the position of its vertex in the order. */
+		struct Instance {
+			Graph graph;
+			Matcher* matcher;
+			/* Revision of the simple graph the instance was built from, 0 if it was built by hand */
+			unsigned long revision;
+			/* Order of the simple graph the instance was built in */
+			std::vector<unsigned int> order;
+
+			Instance();
+			~Instance();
+		};
+		/* Instance of the last simple graph read. Every iteration on the same graph
+		 * in the same order reuses it, so only the matching is calculated again.
+		 * A shuffled graph is built again, lemon sees the permuted nodes and edges. Adding vertices or edges
+		 * by hand removes the instance from the cache, but a solver still holding it
+		 * sees the changes. */
+		static std::shared_ptr<Instance> lastInstance;
+
+		/* List of all vertices, in the order they were added */
 		std::vector<EdmondsVertex<Label>*> vertices;
-		/* Map to store the vertex representation of lemon */
-		std::map < EdmondsVertex<Label>*, Graph::Node> vertexMap;
-		/* Map to create the matching list from the solution provided by lemon */
-		std::map < Graph::Node, EdmondsVertex<Label>*> inverseVertexMap;
-		/* The graph representation used by lemon */
-		Graph* graph;
-		/* The solver object of the lemon implementation */
-		Matcher* matcher;
+		/* Id of the node of every vertex, indexed like vertices */
+		std::vector<int> nodeIds;
+		/* Position of the vertex of every node, indexed by the id of the node */
+		std::vector<unsigned int> positions;
+		/* Id of the first vertex. Vertices of one solver are created consecutively,
+		 * so the position of a vertex follows from its id. */
+		unsigned int firstId;
+		std::shared_ptr<Instance> instance;
+
+		static std::shared_ptr<Instance> buildInstance(SimpleGraph<Label>* g);
+		Graph& getWritableGraph();
+		Graph::Node getNode(EdmondsVertex<Label>* v);
+		unsigned int getMatePosition(unsigned int i);
 	public:
 		EdmondsLemonSolver();
 		inline EdmondsLemonSolver(unsigned int arg1, unsigned int arg2) : EdmondsLemonSolver() {
@@ -32,10 +57,12 @@ namespace maxmatching {
 		};
 		~EdmondsLemonSolver();
 
+		void readGraph(SimpleGraph<Label>* g);
 		void addVertex(EdmondsVertex<Label>* v);
 		void addEdge(EdmondsVertex<Label>* u, EdmondsVertex<Label>* v);
 		void calculateMaxMatching();
 		std::vector<EdmondsVertex<Label>*>* getMatchingRepresentatives();
+		void getMatchingMates(unsigned int* mates);
 		std::vector<std::pair<Label, Label>>* getMatchingLabels();
 		void reset();
 		void clearVertices();
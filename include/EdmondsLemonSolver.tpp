@@ -1,51 +1,173 @@
 #include "EdmondsLemonSolver.h"
 
 namespace maxmatching {
+	template <class Label>
+	std::shared_ptr<typename EdmondsLemonSolver<Label>::Instance> EdmondsLemonSolver<Label>::lastInstance;
+
+	template <class Label>
+	EdmondsLemonSolver<Label>::Instance::Instance()
+		: graph()
+		, revision(0)
+		, order() {
+		this->matcher = new Matcher(this->graph);
+	}
+
+	template <class Label>
+	EdmondsLemonSolver<Label>::Instance::~Instance() {
+		delete(this->matcher);
+	}
+
 	template <class Label>
 	EdmondsLemonSolver<Label>::EdmondsLemonSolver()
 		: vertices()
-		, vertexMap()
-		, inverseVertexMap() {
-		this->graph = new Graph();
-		this->matcher = new Matcher(*this->graph);
-	}
+		, nodeIds()
+		, positions()
+		, firstId(0)
+		, instance() {}
 
 	template <class Label>
 	EdmondsLemonSolver<Label>::~EdmondsLemonSolver() {
 		this->clearVertices();
-		delete(this->matcher);
-		delete(this->graph);
+	}
+
+	/* Builds the lemon graph in bulk with reserved storage. The nodes are added in the order
+	 * of the simple graph and the edges in the order of the shuffled adjacency lists. */
+	template <class Label>
+	std::shared_ptr<typename EdmondsLemonSolver<Label>::Instance> EdmondsLemonSolver<Label>::buildInstance(SimpleGraph<Label>* g) {
+		unsigned int n = g->getVertexCount();
+		auto ret = std::make_shared<Instance>();
+		ret->revision = g->revision;
+		ret->order = g->order;
+		Graph& graph = ret->graph;
+		graph.reserveNode(n);
+		graph.reserveEdge(g->getEdgeCount());
+		/* Maps the index in the simple graph to the node in lemon */
+		std::vector<Graph::Node> nodes(n);
+		for (auto vIndex : g->order) {
+			nodes[vIndex] = graph.addNode();
+		}
+		for (auto vIndex : g->order) {
+			auto u = nodes[vIndex];
+			auto adjList = g->adjacencies[vIndex];
+			for (auto it2 = adjList->begin(); it2 != adjList->end(); it2++) {
+				auto v = nodes[*it2];
+				if (graph.id(u) < graph.id(v)) {
+					graph.addEdge(u, v);
+				}
+			}
+		}
+		return ret;
+	}
+
+	/* Returns the graph of the instance for changes by hand, after taking it out of the cache */
+	template <class Label>
+	typename EdmondsLemonSolver<Label>::Graph& EdmondsLemonSolver<Label>::getWritableGraph() {
+		if (this->instance == nullptr) {
+			this->instance = std::make_shared<Instance>();
+		} else if (this->instance == EdmondsLemonSolver<Label>::lastInstance) {
+			EdmondsLemonSolver<Label>::lastInstance = nullptr;
+		}
+		this->instance->revision = 0;
+		return this->instance->graph;
+	}
+
+	template <class Label>
+	typename EdmondsLemonSolver<Label>::Graph::Node EdmondsLemonSolver<Label>::getNode(EdmondsVertex<Label>* v) {
+		return this->instance->graph.nodeFromId(this->nodeIds[v->id - this->firstId]);
+	}
+
+	/* Returns the position of the mate of the i-th vertex or NoMate */
+	template <class Label>
+	unsigned int EdmondsLemonSolver<Label>::getMatePosition(unsigned int i) {
+		auto lm = this->instance->matcher->mate(this->instance->graph.nodeFromId(this->nodeIds[i]));
+		return lm != lemon::INVALID ? this->positions[this->instance->graph.id(lm)] : NoMate;
+	}
+
+	/* Reuses the lemon graph of the last simple graph read, if it is the same graph in the
+	 * same order. Otherwise it is built again, so shuffling reaches lemon as well. */
+	template <class Label>
+	void EdmondsLemonSolver<Label>::readGraph(SimpleGraph<Label>* g) {
+		unsigned int n = g->getVertexCount();
+		if (this->instance != nullptr) {
+			/* Vertices were added by hand before, the graph is appended to them */
+			unsigned int first = this->vertices.size();
+			for (auto vIndex : g->order) {
+				this->addVertex(new EdmondsVertex<Label>(g->vertexLabel[vIndex]));
+			}
+			std::vector<Graph::Node> nodes(n);
+			for (unsigned int k = 0; k < n; k++) {
+				nodes[g->order[k]] = this->getNode(this->vertices[first + k]);
+			}
+			Graph& graph = this->getWritableGraph();
+			for (unsigned int vIndex = 0; vIndex < n; vIndex++) {
+				auto adjList = g->adjacencies[vIndex];
+				for (auto it2 = adjList->begin(); it2 != adjList->end(); it2++) {
+					if (vIndex < *it2) {
+						graph.addEdge(nodes[vIndex], nodes[*it2]);
+					}
+				}
+			}
+			return;
+		}
+		auto last = EdmondsLemonSolver<Label>::lastInstance;
+		if (last == nullptr || last->revision != g->revision || last->order != g->order) {
+			/* Release the old instance before building the new one */
+			last = nullptr;
+			EdmondsLemonSolver<Label>::lastInstance = nullptr;
+			last = EdmondsLemonSolver<Label>::buildInstance(g);
+			EdmondsLemonSolver<Label>::lastInstance = last;
+		}
+		this->instance = last;
+		this->vertices.reserve(n);
+		this->nodeIds.resize(n);
+		this->positions.resize(n);
+		for (unsigned int k = 0; k < n; k++) {
+			auto vIndex = g->order[k];
+			auto v = new EdmondsVertex<Label>(g->vertexLabel[vIndex]);
+			if (k == 0) {
+				this->firstId = v->id;
+			}
+			this->vertices.push_back(v);
+			this->nodeIds[k] = k;
+			this->positions[k] = k;
+		}
 	}
 
 	template <class Label>
 	void EdmondsLemonSolver<Label>::addVertex(EdmondsVertex<Label>* v) {
-		Graph::Node node = this->graph->addNode();
-		this->vertexMap[v] = node;
-		this->inverseVertexMap[node] = v;
+		if (this->vertices.empty()) {
+			this->firstId = v->id;
+		}
+		Graph& graph = this->getWritableGraph();
+		int id = graph.id(graph.addNode());
+		if (this->positions.size() <= static_cast<unsigned int>(id)) {
+			this->positions.resize(id + 1);
+		}
+		this->positions[id] = this->vertices.size();
+		this->nodeIds.push_back(id);
 		this->vertices.push_back(v);
 	}
 
 	template <class Label>
 	void EdmondsLemonSolver<Label>::addEdge(EdmondsVertex<Label>* u, EdmondsVertex<Label>* v) {
-		this->graph->addEdge(this->vertexMap[u], this->vertexMap[v]);
+		this->getWritableGraph().addEdge(this->getNode(u), this->getNode(v));
 	}
 
+	/* Only the matching is calculated, the graph may have been built by an earlier solver */
 	template <class Label>
 	void EdmondsLemonSolver<Label>::calculateMaxMatching() {
-		this->matcher->run();
+		if (this->instance != nullptr) {
+			this->instance->matcher->run();
+		}
 	}
 
 	template <class Label>
 	std::vector<EdmondsVertex<Label>*>* EdmondsLemonSolver<Label>::getMatchingRepresentatives() {
 		auto ret = new std::vector<EdmondsVertex<Label>*>();
-		for (auto ev : this->vertices) {
-			auto lv = this->vertexMap[ev];
-			auto lm = this->matcher->mate(lv);
-			if (lm != lemon::INVALID) {
-				auto em = this->inverseVertexMap[lm];
-				if (ev->id < em->id) {
-					ret->push_back(ev);
-				}
+		for (unsigned int i = 0; i < this->vertices.size(); i++) {
+			unsigned int j = this->getMatePosition(i);
+			if (j != NoMate && i < j) {
+				ret->push_back(this->vertices[i]);
 			}
 		}
 		return ret;
@@ -54,34 +176,37 @@ namespace maxmatching {
 	template <class Label>
 	std::vector<std::pair<Label, Label>>* EdmondsLemonSolver<Label>::getMatchingLabels() {
 		auto ret = new std::vector<std::pair<Label, Label>>();
-		for (auto ev : this->vertices) {
-			auto lv = this->vertexMap[ev];
-			auto lm = this->matcher->mate(lv);
-			if (lm != lemon::INVALID) {
-				auto em = this->inverseVertexMap[lm];
-				if (ev->id < em->id) {
-					ret->push_back({ ev->label, em->label });
-				}
+		for (unsigned int i = 0; i < this->vertices.size(); i++) {
+			unsigned int j = this->getMatePosition(i);
+			if (j != NoMate && i < j) {
+				ret->push_back({ this->vertices[i]->label, this->vertices[j]->label });
 			}
 		}
 		return ret;
 	}
 
 	template <class Label>
-	void EdmondsLemonSolver<Label>::reset() {
-		delete(this->matcher);
-		this->matcher = new Matcher(*this->graph);
+	void EdmondsLemonSolver<Label>::getMatchingMates(unsigned int* mates) {
+		for (unsigned int i = 0; i < this->vertices.size(); i++) {
+			mates[i] = this->getMatePosition(i);
+		}
 	}
 
+	/* Nothing to do, run initializes the matching again. The matcher may be shared
+	 * with other solvers on the same graph, so it is not replaced. */
+	template <class Label>
+	void EdmondsLemonSolver<Label>::reset() {}
+
+	/* The lemon graph stays cached for the next solver on the same graph */
 	template <class Label>
 	void EdmondsLemonSolver<Label>::clearVertices() {
-		this->graph->clear();
+		this->instance = nullptr;
+		this->nodeIds.clear();
+		this->positions.clear();
 		while (!this->vertices.empty()) {
 			EdmondsVertex<Label>* v = this->vertices.back();
 			this->vertices.pop_back();
 			delete(v);
 		}
-		this->inverseVertexMap.clear();
-		this->vertexMap.clear();
 	}
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+#include <ostream>
+#include <string>
+
+/* Event trace flag. Comment out to remove all trace points at compile time.
+ * If it is defined, but no event category is enabled at runtime, every trace
+ * point costs a single test of the category mask. */
+#define EVENT_TRACE_F
+
+#ifdef EVENT_TRACE_F
+#define TRACE_EVENT(TYPE, A, B)\
+/**/do {\
+/**/	if (maxmatching::EventTrace::isEnabled(TYPE)) {\
+/**/		maxmatching::EventTrace::record(TYPE, A, B);\
+/**/	}\
+/**/} while (0)
+#else
+#define TRACE_EVENT(TYPE, A, B)\
+/**/do {} while (0)
+#endif
+
+namespace maxmatching {
+	/* Categories of traced events. The meaning of the two arguments is:
+	 * EventGrow: parent id, added child id
+	 * EventBlossom: ids of the endpoints of the blossom inducing edge
+	 * EventRotate: old root id, new root id
+	 * EventAugment: ids of the endpoints of the new matching edge
+	 * EventDissolve: root id, number of vertices of the dissolved tree */
+	enum EventType {
+		EventGrow,
+		EventBlossom,
+		EventRotate,
+		EventAugment,
+		EventDissolve,
+		EventTypeCount
+	};
+
+	struct Event {
+		unsigned long seq;
+		EventType type;
+		unsigned long a;
+		unsigned long b;
+	};
+
+	/* Ring buffer keeping the last events of the enabled categories.
+	 * The buffer is dumped if the program crashes or a solver throws,
+	 * which replaces printing the trees on every modification. */
+	class EventTrace {
+	private:
+		EventTrace();
+		~EventTrace();
+
+		static unsigned int enabledMask;
+		static Event* buffer;
+		/* Capacity of the buffer, always a power of two */
+		static unsigned long capacity;
+		static unsigned long nEvents;
+
+		static void crashHandler(int signal);
+	public:
+		/* Largest capacity of the buffer, which takes 512 MB */
+		static const unsigned long MAX_CAPACITY = 1ul << 24;
+
+		/* Rounds the capacity up to a power of two, but at most to MAX_CAPACITY */
+		static void setCapacity(unsigned long capacity);
+		static void setEnabled(EventType type, bool enabled);
+		/* Enables a comma separated list of category names, "all" enables every category.
+		 * Returns false if a name is unknown. */
+		static bool setEnabled(const std::string& categories);
+		static std::string getTypeName(EventType type);
+		/* Dumps the buffered events, oldest first */
+		static void dump(std::ostream& stream);
+		/* Dumps the buffered events to std::cerr on SIGSEGV, SIGBUS, SIGFPE, SIGILL and SIGABRT */
+		static void installCrashHandler();
+
+		static bool isEnabled(EventType type) {
+			return (EventTrace::enabledMask >> type) & 1u;
+		}
+		static void record(EventType type, unsigned long a, unsigned long b) {
+			Event& ev = EventTrace::buffer[EventTrace::nEvents & (EventTrace::capacity - 1)];
+			ev.seq = EventTrace::nEvents++;
+			ev.type = type;
+			ev.a = a;
+			ev.b = b;
+		}
+	};
+}
@@ -1,21 +1,34 @@
 #pragma once
 #include <fstream>
-#include <ostream>
-#include <iostream>
 #include <string>
-#include <map>
+#include <vector>
 #include "Tools.h"
 #include "SimpleGraph.h"
 
 namespace maxmatching {
-	/* Parser from SimpleGraph to the .g file format.
-	 * Each .g file consists of one row with the total vertex count
-	 * and one line for each edge (not necessarily symmetric). */
+	/* Writer for the compressed .g file format. The file starts with the magic "MGRC",
+	 * followed by the format version, the codec and the number of vertices per block as
+	 * 32 bit and the number of vertices and blocks as 64 bit unsigned integers, all in the
+	 * byte order of the machine. Then the offsets of the blocks and of the end of the last
+	 * block follow as 64 bit integers, relative to the end of the offsets.
+	 * A block holds the sorted adjacency lists of consecutive vertices, each one as its
+	 * degree, the zigzag coded difference of the first neighbor to the vertex and the gaps
+	 * between the following neighbors, all as varints. With codec 1, every block is
+	 * compressed with zstd on its own. Blocks are encoded and decoded in parallel. */
 	class GExporter {
+	private:
+		static void writeVarint(unsigned long value, std::string& out);
+		static void encodeBlock(const std::vector<std::vector<unsigned int>*>& rows, unsigned long first, unsigned long end, std::string& out);
 	public:
+		static const char MAGIC[4];
+		static const unsigned int VERSION = 1;
+		static const unsigned int VERTICES_PER_BLOCK = 1 << 16;
+		/* 1 if the blocks are compressed with zstd, 0 otherwise */
+		static const unsigned int CODEC;
+
 		GExporter();
 		~GExporter();
 
 		void writeFile(std::string file, SimpleGraph<unsigned int>* g);
 	};
-}
\ No newline at end of file
+}
@@ -3,39 +3,71 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include <algorithm>
 #include <array>
-#include "boost/graph/random.hpp"
-#include "boost/graph/adjacency_list.hpp"
-#include "boost/graph/undirected_graph.hpp"
+#include <functional>
 #include "SimpleGraph.h"
 #include "DimacsGenerator.h"
-#ifdef HAS_FADE
 #include "TriangleGenerator.h"
-#endif
 #include "Tools.h"
 
 namespace maxmatching {
 	/* Implements all graph generation algorithms considered for benchmarking */
 	class GGenerator {
+	public:
+		/* Receives an edge by the indices of its ends */
+		typedef std::function<void(unsigned int, unsigned int)> EdgeCallback;
+		/* Passes all edges of the block with the given number to the callback */
+		typedef std::function<void(unsigned long, const EdgeCallback&)> EdgeBlock;
 	private:
+		/* Consecutive gadgets of one level of nested blossoms. Gadget g is an odd cycle through
+		 * ports[firstPort + g * cycleLength + i], the ports of its blossoms of the level below. */
+		struct CycleBlock {
+			unsigned long firstPort;
+			unsigned long nGadgets;
+		};
+
+		static void makeNestedBlossoms(unsigned long nBlossoms, unsigned int depth, unsigned int cycleLength, bool randomPorts, unsigned long seed, std::vector<unsigned int>& ports, std::vector<CycleBlock>& blocks);
+		static void addCycles(const std::vector<unsigned int>& ports, const CycleBlock& block, unsigned int cycleLength, const EdgeCallback& addEdge);
+		static void sortAdjacencies(std::vector<std::vector<unsigned int>*>& rows, bool removeParallel);
+		/* Maps a probability to a threshold for 64 bit random numbers */
+		static unsigned long toThreshold(double p);
+		SimpleGraph<unsigned int>* createRandomGrid(unsigned int dim, unsigned int width, unsigned int deleted, unsigned long seed);
 		template <typename VType>
-		SimpleGraph<unsigned int>* createRandomEuclid(unsigned int nVertices, unsigned int nNeighbors, std::mt19937_64 &rgen);
+		SimpleGraph<unsigned int>* createRandomEuclid(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed);
 	public:
+		/* Vertices are labeled by unsigned ints, larger graphs cannot be generated */
+		static const unsigned long MAX_VERTICES = 0xFFFFFFFFul;
+
 		GGenerator();
 		~GGenerator();
 
-		SimpleGraph<unsigned int>* createRandomBoost(unsigned int nVertices, unsigned int nNeighbors, std::mt19937_64 &rgen);
-		SimpleGraph<unsigned int>* createRandomDimacs(unsigned int nVertices, unsigned int nNeighbors, std::mt19937_64 &rgen);
-#ifdef HAS_FADE
-		SimpleGraph<unsigned int>* createRandomTriangle(unsigned int nVertices, std::mt19937_64 &rgen);
-#endif
+		/* Number of vertices of a grid, MAX_VERTICES + 1 if it exceeds MAX_VERTICES */
+		static unsigned long getGridVertexCount(unsigned int dim, unsigned int width);
+
+		/* Adds the edges of independent blocks to a graph. Every block is generated twice
+		 * in parallel, first to count the degrees, then to write the edges into adjacency lists
+		 * of exact size, so no edge list is stored. The lists are sorted afterwards, which makes
+		 * the graph independent of the number of threads, if every block draws from its own
+		 * random stream. Parallel edges are removed, if requested. */
+		static void addEdgeBlocks(SimpleGraph<unsigned int>* graph, unsigned long nBlocks, const EdgeBlock& block, bool removeParallel);
+
+		SimpleGraph<unsigned int>* createRandomBoost(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed);
+		SimpleGraph<unsigned int>* createRandomDimacs(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed);
+		SimpleGraph<unsigned int>* createRandomTriangle(unsigned int nVertices, unsigned long seed);
 #define DECLARE_RANDOM_EUCLID(DIM) \
-		SimpleGraph<unsigned int>* createRandomEuclid ## DIM ## d(unsigned int nVertices, unsigned int nNeighbors, std::mt19937_64 &rgen);
+		SimpleGraph<unsigned int>* createRandomEuclid ## DIM ## d(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed);
 		DECLARE_RANDOM_EUCLID(2);
 		DECLARE_RANDOM_EUCLID(3);
 		DECLARE_RANDOM_EUCLID(10);
 		DECLARE_RANDOM_EUCLID(20);
 #undef DECLARE_RANDOM_EUCLID
+		SimpleGraph<unsigned int>* createRandomRMat(unsigned int nVertices, unsigned int nNeighbors, double a, double b, double c, unsigned long seed);
+		SimpleGraph<unsigned int>* createRandomBarabasiAlbert(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed);
+		SimpleGraph<unsigned int>* createRandomRegular(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed);
+		SimpleGraph<unsigned int>* createRandomGrid2d(unsigned int width, unsigned int deleted, unsigned long seed);
+		SimpleGraph<unsigned int>* createRandomGrid3d(unsigned int width, unsigned int deleted, unsigned long seed);
 		SimpleGraph<unsigned int>* createWorstCaseGabow(unsigned int m);
+		SimpleGraph<unsigned int>* createNestedBlossoms(unsigned int depth, unsigned int branching, unsigned long seed);
+		SimpleGraph<unsigned int>* createBlossomChain(unsigned int nBlossoms, unsigned int depth);
 		SimpleGraph<unsigned int>* createTrianglesA(unsigned int nTriangles);
 		SimpleGraph<unsigned int>* createTrianglesB(unsigned int nTriangles);
 		SimpleGraph<unsigned int>* createHoneyCombs(unsigned int width, unsigned int rows);
@@ -44,12 +76,15 @@ namespace maxmatching {
 		SimpleGraph<unsigned int>* createHoneyCombsInner(unsigned int width, unsigned int rows);
 	};
 
-	/* Create a nearest neighbor graph for any dimension using the euclidean norm */
+	/* Create a nearest neighbor graph for any dimension using the euclidean norm.
+	 * The coordinates of vertex i are drawn from stream i of the seed and
+	 * the neighbors of blocks of vertices are searched in parallel. */
 	template <typename VType>
-	SimpleGraph<unsigned int>* GGenerator::createRandomEuclid(unsigned int nVertices, unsigned int nNeighbors, std::mt19937_64 &rgen) {
+	SimpleGraph<unsigned int>* GGenerator::createRandomEuclid(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed) {
 		auto ret = new SimpleGraph<unsigned int>();
 		std::vector<VType> coords(nVertices);
 		for (unsigned int i = 0; i < nVertices; i++) {
+			RandomStream rgen(seed, i);
 			VType v;
 			for (unsigned int d = 0; d < v.size(); d++) {
 				v[d] = rgen();
@@ -57,20 +92,41 @@ namespace maxmatching {
 			coords[i] = v;
 			ret->addVertex(i);
 		}
+		if (nNeighbors >= nVertices) {
+			nNeighbors = nVertices > 0 ? nVertices - 1 : 0;
+		}
+		std::vector<std::vector<unsigned int>*> rows(nVertices);
 		for (unsigned int i = 0; i < nVertices; i++) {
-			std::vector<double> dists(nVertices);
-			for (unsigned int j = 0; j < nVertices; j++) {
-				dists[j] = Vectors<VType>::distance(coords[i], coords[j]);
-			}
-			std::vector<double> distsCpy(dists);
-			std::sort(distsCpy.begin(), distsCpy.end());
-			for (unsigned int j = 0; j < nVertices; j++) {
-				if (i != j && dists[j] <= distsCpy[nNeighbors]) {
-					ret->addEdgeSym(i, j);
+			rows[i] = ret->adjacencies[i];
+		}
+		/* Every vertex only writes its own list, the reverse edges are added afterwards */
+		const unsigned long verticesPerTask = 64;
+		Parallel::forEach((nVertices + verticesPerTask - 1) / verticesPerTask, [&coords, &rows, nVertices, nNeighbors, verticesPerTask](unsigned long t) {
+			std::vector<double> dists(nVertices), distsCpy(nVertices);
+			for (unsigned long i = t * verticesPerTask; i < std::min<unsigned long>(nVertices, (t + 1) * verticesPerTask); i++) {
+				for (unsigned int j = 0; j < nVertices; j++) {
+					dists[j] = Vectors<VType>::distance(coords[i], coords[j]);
+				}
+				/* The vertex itself is the nearest one */
+				distsCpy = dists;
+				std::nth_element(distsCpy.begin(), distsCpy.begin() + nNeighbors, distsCpy.end());
+				for (unsigned int j = 0; j < nVertices; j++) {
+					if (i != j && dists[j] <= distsCpy[nNeighbors]) {
+						rows[i]->push_back(j);
+					}
 				}
 			}
+		});
+		std::vector<unsigned int> nNearest(nVertices);
+		for (unsigned int i = 0; i < nVertices; i++) {
+			nNearest[i] = rows[i]->size();
+		}
+		for (unsigned int i = 0; i < nVertices; i++) {
+			for (unsigned int k = 0; k < nNearest[i]; k++) {
+				rows[(*rows[i])[k]]->push_back(i);
+			}
 		}
-		ret->cleanUp();
+		GGenerator::sortAdjacencies(rows, true);
 		return ret;
 	}
 }
\ No newline at end of file
@@ -10,16 +10,24 @@
 #include <cstring>
 #include "boost/iostreams/device/mapped_file.hpp"
 #include "SimpleGraph.h"
+#include "GExporter.h"
 
 namespace maxmatching {
-	/* Parser from the .g file format to SimpleGraph.
-	* Each .g file consists of one row with the total vertex count
-	* and one line for each edge (not necessarily symmetric). */
+	/* Parser from the .g file format to SimpleGraph. Files starting with the magic of
+	* GExporter are decoded in parallel by block. Otherwise it is the text format, which
+	* consists of one row with the total vertex count and one line for each edge
+	* (not necessarily symmetric), as written by the TSPParser. */
 	class GImporter {
+	private:
+		static bool readVarint(const unsigned char*& it, const unsigned char* end, unsigned long& value);
+		SimpleGraph<unsigned int>* importCompressed(const char* data, unsigned long size);
+		SimpleGraph<unsigned int>* importText(const char* data, unsigned long size);
 	public:
 		GImporter();
 		~GImporter();
 
 		SimpleGraph<unsigned int>* importFile(const std::string& file);
+		/* Decodes a file already in memory, e.g. mapped by the instance store */
+		SimpleGraph<unsigned int>* importData(const char* data, unsigned long size);
 	};
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "GImporter.h"
 #include "GExporter.h"
 #include "GGenerator.h"
+#include "InstanceStore.h"
 
 namespace maxmatching {
 	/* Container class for different sources of instances for benchmarking. */
@@ -76,11 +77,12 @@ namespace maxmatching {
 	/* Uses a graph generator to create benchmarking instances. */
 	class GeneratorGraphSource : public GraphSource {
 	private:
-		std::string tmpFile;
+		unsigned long long key;
 		std::string string;
 		std::function<SimpleGraph<unsigned int>* (GGenerator)> generator;
 	public:
-		GeneratorGraphSource(std::string tmpFile, std::string string, std::function<SimpleGraph<unsigned int>* (GGenerator)> generator);
+		/* The key identifies the generated instance in the InstanceStore */
+		GeneratorGraphSource(unsigned long long key, std::string string, std::function<SimpleGraph<unsigned int>* (GGenerator)> generator);
 		~GeneratorGraphSource();
 		SimpleGraph<unsigned int>* getNext();
 		std::string printSource();
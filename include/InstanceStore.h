@@ -0,0 +1,46 @@
+#pragma once
+#include <functional>
+#include <string>
+#include "TypeEnums.h"
+#include "SimpleGraph.h"
+
+namespace maxmatching {
+	/* Content addressed store for the generated and parsed graphs in assets/tmp/store.
+	 * Every instance is keyed by a hash of its source type, the version of that source and
+	 * its parameters including the seed. It is stored as <key>.g together with a manifest
+	 * <key>.meta holding the file size, a checksum, the modification time, the creation time
+	 * and a description. Both files are written under a temporary name and renamed afterwards,
+	 * so parallel workers sharing the store only ever see complete files. An instance, whose
+	 * size, modification time or checksum does not match its manifest or which cannot be
+	 * decoded, is created again.
+	 * The modification time of a manifest marks the last use of its instance, the least
+	 * recently used instances are evicted on startup until the store fits into its capacity. */
+	class InstanceStore {
+	private:
+		InstanceStore();
+		~InstanceStore();
+
+		static const std::string DIR;
+		/* Temporary files of crashed workers and instances without a manifest
+		 * are removed after this many seconds */
+		static const long STALE_SECONDS = 24 * 60 * 60;
+
+		static unsigned int getVersion(SourceType type);
+		static std::string toHex(unsigned long long value);
+		static std::string getManifest(unsigned long long key);
+		static std::string makeTemporary(const std::string& file);
+		static unsigned long long checksum(const char* data, unsigned long size);
+	public:
+		/* Evicts the least recently used instances until the store holds at most <capacity> bytes.
+		 * Orphaned instances, manifests and stale temporary files are removed as well. */
+		static void open(unsigned long capacity);
+
+		static unsigned long long makeKey(SourceType type, const std::string& parameters);
+		static std::string getFile(unsigned long long key);
+		/* Decodes the instance, if it is stored and matches its manifest, otherwise
+		 * returns nullptr. Marks it as used. */
+		static SimpleGraph<unsigned int>* load(unsigned long long key);
+		/* Lets the writer create the instance in a temporary file and moves it into the store */
+		static void add(unsigned long long key, const std::string& description, const std::function<void(const std::string&)>& writer);
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <functional>
+#include <string>
+
+namespace maxmatching {
+	/* Outcome of a task run in a child process */
+	enum IsolationResult {
+		/* The task returned, its return value is the exit code */
+		IsolationExited,
+		/* The task exceeded the wall clock limit and was killed */
+		IsolationTimeout,
+		/* The child was terminated by a signal, e.g. a segmentation fault
+		 * or the kernel's out of memory killer */
+		IsolationSignaled
+	};
+
+	/* Runs tasks in forked child processes with a wall clock timeout and a cap
+	 * on the address space (RLIMIT_AS). The child shares all data of the parent
+	 * copy on write, so e.g. loaded graphs are not read again. Results are
+	 * passed back over a pipe as a byte string. */
+	class Isolation {
+	private:
+		Isolation();
+		~Isolation();
+
+		static bool enabled;
+		/* Wall clock limit in seconds, 0 means unlimited */
+		static unsigned int timeout;
+		/* Address space limit in MiB, 0 means unlimited */
+		static unsigned long memoryLimit;
+	public:
+		static void setEnabled(unsigned int timeout, unsigned long memoryLimit);
+		static bool isEnabled();
+
+		/* Runs the task in a child process. The task returns its exit code and
+		 * fills the output string, which is transferred to the parent.
+		 * If the result is IsolationSignaled, code is the signal number. */
+		static IsolationResult run(const std::function<int(std::string&)>& task, int& code, std::string& output);
+	};
+}
@@ -3,8 +3,16 @@
 #include <sstream>
 #include "GraphSource.h"
 #include "TypeEnums.h"
+#include "IntStepper.h"
 
 namespace maxmatching {
+	/* Solver with one combination of its arguments */
+	struct SolverConfig {
+		SolverType type;
+		unsigned int arg1;
+		unsigned int arg2;
+	};
+
 	/* Wrapper class to add additional information to a graph source */
 	class Job {
 	private:
@@ -16,6 +24,9 @@ namespace maxmatching {
 		SolverType solver;
 		unsigned int solverArg1;
 		unsigned int solverArg2;
+		/* All solvers benchmarked on the graphs of the job. The one currently
+		 * running is stored in solver, solverArg1 and solverArg2. */
+		std::vector<SolverConfig> solvers;
 
 		Job();
 		virtual ~Job();
@@ -26,8 +37,19 @@ namespace maxmatching {
 		virtual bool isCompound();
 		virtual Job* nextSubJob();
 
+		void selectSolver(const SolverConfig& config);
+		std::string getSolverName();
 		std::string createCsvHeader();
 		std::string createCsvData();
+
+		/* Look up the command line flag of a graph source (e.g. -Gr) or a solver (e.g. -mgqpt).
+		 * nArgs is set to the number of arguments following the flag. */
+		static bool findSourceFlag(const std::string& flag, SourceType& type, unsigned int& nArgs);
+		static bool findSolverFlag(const std::string& flag, SolverType& type, unsigned int& nArgs);
+		/* The command line flag of a graph source, which stays the same when sources are added */
+		static std::string getSourceFlag(SourceType type);
+		/* Adds a config for every combination of the solver arguments */
+		static void expandSolver(SolverType type, IntStepper args1, IntStepper args2, std::vector<SolverConfig>& configs);
 	};
 
 	/* Wrapper class to combine multiple jobs */
@@ -0,0 +1,44 @@
+#pragma once
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace maxmatching {
+	/* Result of a single benchmark iteration as stored in the ledger */
+	struct LedgerEntry {
+		/* Empty if the iteration finished, otherwise the failure status */
+		std::string failure;
+		int matching;
+		/* Raw measurement as created by Statistics::serializeCurrent */
+		std::string measurement;
+	};
+
+	/* Append only record of finished benchmark iterations. Every iteration is
+	 * keyed by a hash of its source, solver, solver arguments, seed, shuffle flag
+	 * and iteration index. Entries are flushed as soon as they are written,
+	 * so a killed benchmark can be restarted with the same arguments and only
+	 * runs the iterations missing from the ledger. */
+	class Ledger {
+	private:
+		Ledger();
+		~Ledger();
+
+		static std::ofstream* out;
+		static std::unordered_map<unsigned long long, LedgerEntry> entries;
+
+		static void write(unsigned long long key, const LedgerEntry& entry);
+		static std::string toHex(const std::string& data);
+		static bool fromHex(const std::string& hex, std::string& data);
+	public:
+		/* Loads all complete entries of the file and appends new ones to it */
+		static void open(const std::string& file);
+		static void close();
+		static bool isEnabled();
+
+		static unsigned long long makeKey(const std::string& source, const std::string& solver, unsigned int solverArg1, unsigned int solverArg2, unsigned long seed, bool shuffle, unsigned int iteration);
+		/* Returns the stored entry for the key or nullptr */
+		static const LedgerEntry* find(unsigned long long key);
+		static void addResult(unsigned long long key, int matching, const std::string& measurement);
+		static void addFailure(unsigned long long key, const std::string& failure);
+	};
+}
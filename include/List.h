@@ -26,6 +26,7 @@ namespace maxmatching {
 		T* pop();
 		ListElement<T>* popElem();
 		void remove(ListElement<T>* elem);
+		void splice(List<T>* other);
 		void clear();
 
 		void deleteStructure();
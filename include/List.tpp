@@ -107,6 +107,27 @@ namespace maxmatching {
 		this->size--;
 	}
 
+	/* Moves all elements of the other list to the end of this list */
+	template<class T>
+	void List<T>::splice(List<T>* other) {
+		if (other == this || other->firstElem == nullptr) {
+			return;
+		}
+		for (ListElement<T>* iter = other->firstElem; iter != nullptr; iter = iter->nxtElem) {
+			iter->containingList = this;
+		}
+		other->firstElem->prvElem = this->lastElem;
+		if (this->lastElem != nullptr) {
+			this->lastElem->nxtElem = other->firstElem;
+		} else {
+			this->firstElem = other->firstElem;
+		}
+		this->lastElem = other->lastElem;
+		this->size += other->size;
+		other->firstElem = other->lastElem = nullptr;
+		other->size = 0;
+	}
+
 	template<class T>
 	void List<T>::clear() {
 		while (this->size > 0) {
@@ -0,0 +1,36 @@
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+#include "SimpleGraph.h"
+
+namespace maxmatching {
+	/* Checks matchings computed by the solvers against the base graph.
+	 * A matching is valid, if all its pairs are edges of the graph and no
+	 * vertex is matched twice. Maximality is proven with the Tutte-Berge formula:
+	 * For every vertex set A, a matching has at most (|V| + |A| - odd(G - A)) / 2 edges,
+	 * where odd(G - A) is the number of odd components of the graph without A.
+	 * A is the set of odd (inner) vertices of an Edmonds-Gallai decomposition, which is
+	 * found by one alternating forest search from all exposed vertices in O(m alpha(n)).
+	 * The bound is checked independently of the search, so a wrong search can never
+	 * certify a matching, which is not maximum. */
+	template<class Label>
+	class MatchingVerifier {
+	private:
+		MatchingVerifier();
+		~MatchingVerifier();
+
+		/* Union-find with path halving */
+		static unsigned int find(std::vector<unsigned int>& sets, unsigned int v);
+		/* Grows an alternating forest from all exposed vertices. Returns false, if an
+		 * augmenting path was found. Otherwise the labels are 1 for even, 2 for odd
+		 * and 0 for vertices not reachable by an alternating path. */
+		static bool searchForest(SimpleGraph<Label>* graph, const std::vector<int>& mate, std::vector<unsigned char>& labels);
+	public:
+		/* Returns false and sets the error message, if the matching is not valid
+		 * or could not be certified to be maximum. */
+		static bool verify(SimpleGraph<Label>* graph, const std::vector<std::pair<Label, Label>>& matching, std::string& error);
+	};
+}
+
+#include "MatchingVerifier.tpp"
@@ -0,0 +1,191 @@
+#include "MatchingVerifier.h"
+
+namespace maxmatching {
+	template<class Label>
+	unsigned int MatchingVerifier<Label>::find(std::vector<unsigned int>& sets, unsigned int v) {
+		while (sets[v] != v) {
+			sets[v] = sets[sets[v]];
+			v = sets[v];
+		}
+		return v;
+	}
+
+	/* Edmonds' search without augmentation: Even vertices are scanned, unlabeled
+	 * neighbors get odd and their partners even. An edge between even vertices of
+	 * different trees is an augmenting path, within a tree it closes a blossom,
+	 * which is contracted with the union-find structure onto its base. */
+	template<class Label>
+	bool MatchingVerifier<Label>::searchForest(SimpleGraph<Label>* graph, const std::vector<int>& mate, std::vector<unsigned char>& labels) {
+		const unsigned char even = 1, odd = 2;
+		const unsigned int none = ~0u;
+		unsigned int n = graph->getVertexCount();
+		labels.assign(n, 0);
+		/* Even vertex an odd vertex was reached from */
+		std::vector<unsigned int> parent(n, none);
+		std::vector<unsigned int> root(n, none);
+		/* Blossoms as disjoint sets, base holds the base of each set representative */
+		std::vector<unsigned int> sets(n), base(n), rank(n, 0);
+		std::vector<unsigned int> mark(n, 0);
+		unsigned int stamp = 0;
+		std::vector<unsigned int> queue;
+		queue.reserve(n);
+		for (unsigned int v = 0; v < n; v++) {
+			sets[v] = v;
+			base[v] = v;
+			if (mate[v] < 0) {
+				labels[v] = even;
+				root[v] = v;
+				queue.push_back(v);
+			}
+		}
+		auto baseOf = [&](unsigned int v) {
+			return base[MatchingVerifier<Label>::find(sets, v)];
+		};
+		/* Next blossom base on the way to the root */
+		auto up = [&](unsigned int b) {
+			return mate[b] < 0 ? none : baseOf(parent[mate[b]]);
+		};
+		auto link = [&](unsigned int v, unsigned int lca) {
+			unsigned int rv = MatchingVerifier<Label>::find(sets, v);
+			unsigned int rl = MatchingVerifier<Label>::find(sets, lca);
+			if (rv == rl) {
+				return;
+			}
+			if (rank[rv] > rank[rl]) {
+				std::swap(rv, rl);
+			} else if (rank[rv] == rank[rl]) {
+				rank[rl]++;
+			}
+			sets[rv] = rl;
+			base[rl] = lca;
+		};
+		/* Merges all blossoms on the path from b to the lca, odd vertices become even */
+		auto contract = [&](unsigned int b, unsigned int lca) {
+			while (b != lca) {
+				unsigned int o = mate[b];
+				link(b, lca);
+				link(o, lca);
+				labels[o] = even;
+				queue.push_back(o);
+				b = baseOf(parent[o]);
+			}
+		};
+		for (unsigned int head = 0; head < queue.size(); head++) {
+			unsigned int v = queue[head];
+			std::vector<unsigned int>* adjList = graph->adjacencies[v];
+			for (unsigned int w : *adjList) {
+				if (labels[w] == odd) {
+					continue;
+				}
+				if (labels[w] == 0) {
+					unsigned int m = mate[w];
+					labels[w] = odd;
+					parent[w] = v;
+					root[w] = root[v];
+					labels[m] = even;
+					root[m] = root[v];
+					queue.push_back(m);
+					continue;
+				}
+				unsigned int bv = baseOf(v), bw = baseOf(w);
+				if (bv == bw) {
+					continue;
+				}
+				if (root[v] != root[w]) {
+					return false;
+				}
+				/* Walk up both sides alternately until one reaches a marked base */
+				stamp++;
+				unsigned int x = bv, y = bw, lca;
+				while (true) {
+					if (x != none) {
+						if (mark[x] == stamp) {
+							lca = x;
+							break;
+						}
+						mark[x] = stamp;
+						x = up(x);
+					}
+					std::swap(x, y);
+				}
+				contract(bv, lca);
+				contract(bw, lca);
+			}
+		}
+		return true;
+	}
+
+	template<class Label>
+	bool MatchingVerifier<Label>::verify(SimpleGraph<Label>* graph, const std::vector<std::pair<Label, Label>>& matching, std::string& error) {
+		unsigned int n = graph->getVertexCount();
+		std::vector<int> mate(n, -1);
+		for (auto& pair : matching) {
+			auto uIt = graph->indexMap.find(pair.first);
+			auto vIt = graph->indexMap.find(pair.second);
+			std::stringstream msg;
+			if (uIt == graph->indexMap.end() || vIt == graph->indexMap.end()) {
+				msg << "Matched pair (" << pair.first << ", " << pair.second << ") contains an unknown vertex";
+			} else if (uIt->second == vIt->second) {
+				msg << "Vertex " << pair.first << " is matched to itself";
+			} else if (mate[uIt->second] >= 0 || mate[vIt->second] >= 0) {
+				msg << "Matched pair (" << pair.first << ", " << pair.second << ") contains an already matched vertex";
+			} else {
+				auto adjList = graph->adjacencies[uIt->second];
+				if (std::find(adjList->begin(), adjList->end(), vIt->second) == adjList->end()) {
+					msg << "Matched pair (" << pair.first << ", " << pair.second << ") is not an edge";
+				}
+			}
+			if (!msg.str().empty()) {
+				error = msg.str();
+				return false;
+			}
+			mate[uIt->second] = vIt->second;
+			mate[vIt->second] = uIt->second;
+		}
+		std::vector<unsigned char> labels;
+		if (!MatchingVerifier<Label>::searchForest(graph, mate, labels)) {
+			std::stringstream msg;
+			msg << "Found an augmenting path, the matching of size " << matching.size() << " is not maximum";
+			error = msg.str();
+			return false;
+		}
+		/* Components of the graph without the odd vertices */
+		const unsigned char odd = 2;
+		std::vector<unsigned int> sets(n), sizes(n, 0);
+		for (unsigned int v = 0; v < n; v++) {
+			sets[v] = v;
+		}
+		unsigned int nOdd = 0;
+		for (unsigned int v = 0; v < n; v++) {
+			if (labels[v] == odd) {
+				nOdd++;
+				continue;
+			}
+			for (unsigned int w : *graph->adjacencies[v]) {
+				if (labels[w] != odd) {
+					sets[MatchingVerifier<Label>::find(sets, w)] = MatchingVerifier<Label>::find(sets, v);
+				}
+			}
+		}
+		for (unsigned int v = 0; v < n; v++) {
+			if (labels[v] != odd) {
+				sizes[MatchingVerifier<Label>::find(sets, v)]++;
+			}
+		}
+		unsigned int oddComponents = 0;
+		for (unsigned int v = 0; v < n; v++) {
+			if (sizes[v] % 2 == 1) {
+				oddComponents++;
+			}
+		}
+		unsigned long bound = (n + nOdd - oddComponents) / 2;
+		if (matching.size() != bound) {
+			std::stringstream msg;
+			msg << "Could not certify maximality, the matching has " << matching.size()
+				<< " edges, the Tutte-Berge bound is " << bound;
+			error = msg.str();
+			return false;
+		}
+		return true;
+	}
+}
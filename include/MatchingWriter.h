@@ -0,0 +1,35 @@
+#pragma once
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace maxmatching {
+	/* Writes the matching of every benchmarked instance to a file.
+	 * The binary format starts with the magic "MMAT" and a version number,
+	 * followed by one record per instance, all numbers as 32 bit unsigned
+	 * integers in the byte order of the machine:
+	 *   length of the instance name, the name itself, n, flags,
+	 *   n labels (only if flag 1 is set), n mates.
+	 * Mates are the positions of the partners in the label array or 0xFFFFFFFF.
+	 * The labels are left out, if the label of every vertex is its position.
+	 * The text format lists every matched pair of labels in one line,
+	 * headed by a comment line with the instance name. */
+	class MatchingWriter {
+	private:
+		MatchingWriter();
+		~MatchingWriter();
+
+		static std::ofstream* out;
+		static bool binary;
+
+		static void writeInt(unsigned int value);
+	public:
+		static void open(const std::string& file, bool binary);
+		static void close();
+		static bool isEnabled();
+
+		/* Writes the mate array of one instance, with the vertices
+		 * numbered in the order of their labels */
+		static void write(const std::string& instance, const std::vector<unsigned int>& labels, const std::vector<unsigned int>& mates);
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+namespace maxmatching {
+	/* Counts heap allocations through replacements of the global operator new
+	 * and operator delete. Counting is disabled by default, in which case the
+	 * replacements only cost a single branch. Live and peak heap bytes are
+	 * only available when the allocator can report the size of a block (glibc). */
+	class MemoryTracker {
+	private:
+		MemoryTracker();
+		~MemoryTracker();
+
+		static std::atomic<bool> enabled;
+		static std::atomic<unsigned long> nAllocations;
+		static std::atomic<unsigned long> allocatedBytes;
+		static std::atomic<long> liveBytes;
+		static std::atomic<long> peakLiveBytes;
+		/* Live bytes at the start of the current run */
+		static long baseLiveBytes;
+	public:
+		static void setEnabled(bool enabled);
+		static bool isEnabled();
+
+		/* Hooks for the global operator new and delete */
+		static void recordAllocation(void* ptr);
+		static void recordDeallocation(void* ptr);
+
+		/* Starts a new run, i.e. resets all counters and the peak resident set size */
+		static void startRun();
+		/* Peak heap bytes above the live bytes at the start of the run */
+		static unsigned long getPeakHeapBytes();
+		static unsigned long getAllocatedBytes();
+		static unsigned long getAllocations();
+		/* Peak resident set size of the process. It can only be reset for a run
+		 * if the kernel supports clearing it via /proc/self/clear_refs. */
+		static unsigned long getPeakResidentBytes();
+	};
+}
@@ -18,6 +18,9 @@ namespace maxmatching {
 	private:
 		/* List of all vertices. Basically the graph representation. */
 		std::vector<Vertex<Label>*> vertices;
+		/* Position of every vertex in the order it was added, indexed by its id relative
+		 * to the smallest id. Empty as long as preSort did not renumber the vertices. */
+		std::vector<unsigned int> positions;
 		/* GrowQueue containing all vertices, from which growing is possible */
 		List<Vertex<Label>> growQueue;
 		/* Internal flag to force a restart of the algorithm. Should probably be
@@ -25,6 +28,7 @@ namespace maxmatching {
 		bool isCalculated;
 
 		void preSort();
+		unsigned int getPosition(Vertex<Label>* v, unsigned int firstId);
 		void greedyPreSolve();
 	public:
 		/* Enum to describe which strategy to use for sorting the vertices
@@ -44,6 +48,7 @@ namespace maxmatching {
 		void addEdge(Vertex<Label>* u, Vertex<Label>* v);
 		std::vector<std::pair<Vertex<Label>*, Vertex<Label>*>>* getMatching();
 		std::vector<Vertex<Label>*>* getMatchingRepresentatives();
+		void getMatchingMates(unsigned int* mates);
 		std::vector<std::pair<Label, Label>>* getMatchingLabels();
 		void reset();
 		//void shuffle(std::mt19937 g);
@@ -54,6 +59,7 @@ namespace maxmatching {
 		void dissolveTwinTree(CherryTree<Label>* lTree, CherryTree<Label>* rTree);
 
 		void clearVertices();
+		static void prepareScratch();
 	};
 }
 
@@ -15,6 +15,12 @@ namespace maxmatching {
 	MultiTreeSolver<Label>::~MultiTreeSolver() {}
 
 	/* Clear the vertex list and also delete all contained vertices */
+	/* The trees share their scratch space across solvers */
+	template <class Label>
+	void MultiTreeSolver<Label>::prepareScratch() {
+		CherryTree<Label>::resetScratch();
+	}
+
 	template <class Label>
 	void MultiTreeSolver<Label>::clearVertices() {
 		while (!this->vertices.empty()) {
@@ -23,6 +29,7 @@ namespace maxmatching {
 			delete(v);
 		}
 		this->vertices.shrink_to_fit();
+		this->positions.clear();
 	}
 
 	/* Sorts the vertices according to the defined presort strategy */
@@ -67,6 +74,13 @@ namespace maxmatching {
 				}
 				break;
 		}
+		/* Remember the positions, since the ids are the only link to them */
+		std::vector<unsigned int> sortedPositions(this->vertices.size());
+		for (unsigned int i = 0; i < this->vertices.size(); i++) {
+			unsigned int id = this->vertices[i]->id - minId;
+			sortedPositions[i] = this->positions.empty() ? id : this->positions[id];
+		}
+		this->positions.swap(sortedPositions);
 		for (unsigned int i = 0; i < this->vertices.size(); i++) {
 			Vertex<Label>* v = this->vertices[i];
 			v->id = minId + i;
@@ -144,6 +158,28 @@ namespace maxmatching {
 		return ret;
 	}
 
+	template <class Label>
+	unsigned int MultiTreeSolver<Label>::getPosition(Vertex<Label>* v, unsigned int firstId) {
+		unsigned int id = v->id - firstId;
+		return this->positions.empty() ? id : this->positions[id];
+	}
+
+	/* The ids of the vertices are consecutive, preSort keeps the positions they were added at */
+	template <class Label>
+	void MultiTreeSolver<Label>::getMatchingMates(unsigned int* mates) {
+		if (this->vertices.empty()) {
+			return;
+		}
+		unsigned int firstId = this->vertices[0]->id;
+		for (auto v : this->vertices) {
+			firstId = std::min(firstId, v->id);
+		}
+		for (auto v : this->vertices) {
+			auto w = v->getMatchingPartner();
+			mates[this->getPosition(v, firstId)] = w != nullptr ? this->getPosition(w, firstId) : NoMate;
+		}
+	}
+
 	template <class Label>
 	void MultiTreeSolver<Label>::reset() {
 		for (auto it = this->vertices.begin(); it != this->vertices.end(); it++) {
@@ -159,8 +195,12 @@ namespace maxmatching {
 			reset();
 		}
 		/* Start with a fast approximation */
+		Statistics::startPhase(PhasePreSort);
 		preSort();
+		Statistics::stopPhase(PhasePreSort);
+		Statistics::startPhase(PhaseGreedy);
 		greedyPreSolve();
+		Statistics::stopPhase(PhaseGreedy);
 		DEBUG("Finished greedy approximation\n");
 		/* Initialize problem */
 		for (auto it = this->vertices.begin(); it != this->vertices.end(); it++) {
@@ -172,10 +212,12 @@ namespace maxmatching {
 			}
 		}
 		/* Growing */
+		Statistics::startPhase(PhaseGrow);
 		while (!this->growQueue.isEmpty()) {
 			Vertex<Label>* v = this->growQueue.popElem()->value;
 			this->growFrom(v);
 		}
+		Statistics::stopPhase(PhaseGrow);
 		isCalculated = true;
 	}
 
@@ -196,16 +238,17 @@ namespace maxmatching {
 			if (w->isEven()) {
 				if (tw == tv) {
 					/* In the same tree -> check for blossom creation */
+					Statistics::startPhase(PhaseShrink);
 					tw->makeBlossom(v, w);
+					Statistics::stopPhase(PhaseShrink);
 				} else {
 					/* In another tree -> rotate trees to a twin tree */
 					DEBUG("Rotating and matching " << v->id << " and " << w->id << "\n");
-					tw->printTree();
-					tv->printTree();
 					tw->rotate(w);
 					tv->rotate(v);
 					v->setMatchingPartner(w);
 					w->setMatchingPartner(v);
+					TRACE_EVENT(EventAugment, v->id, w->id);
 					this->dissolveTwinTree(tw, tv);
 					break;
 				}
@@ -225,6 +268,7 @@ namespace maxmatching {
 		for (int i = 0; i < 2; i++) {
 			CherryTree<Label>* tree = i == 0 ? lTree : rTree;
 			auto lvs = tree->getVertices();
+			TRACE_EVENT(EventDissolve, tree->root->id, lvs->getSize());
 			/* Remove references to the old tree */
 			while (!lvs->isEmpty()) {
 				Vertex<Label>* s = lvs->pop();
@@ -0,0 +1,44 @@
+#pragma once
+#include <vector>
+#include <string>
+
+namespace maxmatching {
+	/* Hardware events recorded by the PerfCounters */
+	enum PerfEvent {
+		PerfCycles,
+		PerfInstructions,
+		PerfCacheMisses,
+		PerfBranchMisses,
+		PerfEventCount
+	};
+
+	/* Optional backend for hardware performance counters using the Linux
+	 * perf_event_open interface. All events are opened as one group for the
+	 * calling thread. If the kernel does not permit (some of) the counters,
+	 * e.g. due to perf_event_paranoid, the missing ones read as 0. */
+	class PerfCounters {
+	private:
+		PerfCounters();
+		~PerfCounters();
+
+		static bool enabled;
+		static bool initialized;
+		/* File descriptor of the group leader, -1 if not available */
+		static int leaderFd;
+		static int fds[PerfEventCount];
+		/* Position of each event in a group read, -1 if not available */
+		static int groupIndex[PerfEventCount];
+		static unsigned int nOpened;
+
+		static void init();
+	public:
+		static void setEnabled(bool enabled);
+		static bool isEnabled();
+		static bool isAvailable(PerfEvent event);
+		/* Resets and starts counting */
+		static void start();
+		/* Stops counting and adds the counted values to the given array */
+		static void stop(unsigned long* values);
+		static void close();
+	};
+}
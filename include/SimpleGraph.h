@@ -5,7 +5,7 @@
 #include <map>
 #include <vector>
 #include <algorithm>
-#include <random>
+#include "Tools.h"
 
 namespace maxmatching {
 	/* Base class to buffer graphs in a uniform representation
@@ -15,10 +15,18 @@ namespace maxmatching {
 	private:
 		unsigned int indexCtr;
 		static unsigned int prtCtr;
+		static unsigned long revisionCtr;
 	public:
 		std::vector<Label> vertexLabel;
 		std::map<Label, unsigned int> indexMap;
 		std::map<unsigned int, std::vector<unsigned int>*> adjacencies;
+		/* Indices of the vertices in the order they are fed to the solvers.
+		 * Shuffling permutes this order instead of relabeling the graph. */
+		std::vector<unsigned int> order;
+		/* Unique for every graph and renewed by addVertex and the addEdge methods, so
+		 * structures derived from the graph can be reused as long as it stays the same.
+		 * Shuffling keeps it, since the order is not part of the graph. */
+		unsigned long revision;
 
 		SimpleGraph();
 		~SimpleGraph();
@@ -29,10 +37,10 @@ namespace maxmatching {
 		void addEdgeSymSafe(Label start, Label end);
 		void cleanUp();
 
-		void shuffle(std::mt19937_64 g);
+		void shuffle(unsigned long seed);
 
 		unsigned int getVertexCount();
-		unsigned int getEdgeCount();
+		unsigned long getEdgeCount();
 		void print();
 	};
 }
@@ -3,13 +3,17 @@
 namespace maxmatching {
 	template<class Label>
 	unsigned int SimpleGraph<Label>::prtCtr = 0;
+	template<class Label>
+	unsigned long SimpleGraph<Label>::revisionCtr = 0;
 
 	template<class Label>
 	SimpleGraph<Label>::SimpleGraph()
 		: indexCtr(0)
 		, vertexLabel()
 		, indexMap()
-		, adjacencies() {}
+		, adjacencies()
+		, order()
+		, revision(++SimpleGraph<Label>::revisionCtr) {}
 
 	template<class Label>
 	SimpleGraph<Label>::~SimpleGraph() {
@@ -24,7 +28,9 @@ namespace maxmatching {
 		this->vertexLabel.push_back(v);
 		auto index = indexCtr++;
 		this->indexMap[v] = index;
+		this->order.push_back(index);
 		this->adjacencies[index] = new std::vector<unsigned int>();
+		this->revision = ++SimpleGraph<Label>::revisionCtr;
 	}
 
 	template<class Label>
@@ -33,6 +39,7 @@ namespace maxmatching {
 		auto v = indexMap[end];
 		auto uList = this->adjacencies[u];
 		uList->push_back(v);
+		this->revision = ++SimpleGraph<Label>::revisionCtr;
 	}
 
 	template<class Label>
@@ -43,6 +50,7 @@ namespace maxmatching {
 		uList->push_back(v);
 		auto vList = this->adjacencies[v];
 		vList->push_back(u);
+		this->revision = ++SimpleGraph<Label>::revisionCtr;
 	}
 
 	template<class Label>
@@ -57,6 +65,7 @@ namespace maxmatching {
 		if (std::find(vList->begin(), vList->end(), u) == vList->end()) {
 			vList->push_back(u);
 		}
+		this->revision = ++SimpleGraph<Label>::revisionCtr;
 	}
 
 	/* Removes duplicate entries in the adjacency lists. */
@@ -70,38 +79,37 @@ namespace maxmatching {
 		}
 	}
 
-	/* Shuffles the vertex list and the adjacency lists, thus creating an isomorphic graph. */
+	/* Shuffles the vertex order and the adjacency lists, thus creating an isomorphic graph.
+	 * The indices stay the same, so no relabeled copy of the graph is built. The order uses
+	 * stream 0 of the seed, the adjacency list of vertex i stream i + 1. The lists are shuffled
+	 * in place by parallel tasks, so the result does not depend on the number of threads. */
 	template<class Label>
-	void SimpleGraph<Label>::shuffle(std::mt19937_64 g) {
-		std::vector<unsigned int> rename(this->indexCtr);
-		for (unsigned int i = 0; i < this->indexCtr; i++) {
-			rename[i] = i;
-		}
-		std::shuffle(rename.begin(), rename.end(), g);
-		for (auto it = this->indexMap.begin(); it != this->indexMap.end(); it++) {
-			this->indexMap[it->first] = rename[it->second];
+	void SimpleGraph<Label>::shuffle(unsigned long seed) {
+		RandomStream g(seed, 0);
+		std::shuffle(this->order.begin(), this->order.end(), g);
+		std::vector<std::vector<unsigned int>*> rows;
+		rows.reserve(this->adjacencies.size());
+		for (auto& pair : this->adjacencies) {
+			rows.push_back(pair.second);
 		}
-		std::map<unsigned int, std::vector<unsigned int>*> newAdjacencies;
-		for (auto it = this->adjacencies.begin(); it != this->adjacencies.end(); it++) {
-			auto adjList = it->second;
-			for (unsigned int i = 0; i < adjList->size(); i++) {
-				(*adjList)[i] = rename[(*adjList)[i]];
+		const unsigned long rowsPerTask = 4096;
+		unsigned long nRows = rows.size();
+		Parallel::forEach((nRows + rowsPerTask - 1) / rowsPerTask, [&rows, nRows, rowsPerTask, seed](unsigned long t) {
+			for (unsigned long i = t * rowsPerTask; i < std::min(nRows, (t + 1) * rowsPerTask); i++) {
+				RandomStream adjG(seed, i + 1);
+				std::shuffle(rows[i]->begin(), rows[i]->end(), adjG);
 			}
-			std::shuffle(adjList->begin(), adjList->end(), g);
-			newAdjacencies[rename[it->first]] = adjList;
-		}
-		this->adjacencies = newAdjacencies;
+		});
 	}
 
-
 	template<class Label>
 	unsigned int SimpleGraph<Label>::getVertexCount() {
 		return this->indexMap.size();
 	}
 
 	template<class Label>
-	unsigned int SimpleGraph<Label>::getEdgeCount() {
-		unsigned int ret = 0;
+	unsigned long SimpleGraph<Label>::getEdgeCount() {
+		unsigned long ret = 0;
 		for (auto pair : this->adjacencies) {
 			ret += pair.second->size();
 		}
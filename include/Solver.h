@@ -5,6 +5,9 @@
 #include "SimpleGraph.h"
 
 namespace maxmatching {
+	/* Entry of a mate array for an unmatched vertex */
+	const unsigned int NoMate = 0xFFFFFFFF;
+
 	/* Base class for solvers. Solvers use the added vertices.
 	 * Adding edges is only a comfort function, which makes the necessary calls
 	 * on the vertices. Added edges will thus survive in the vertices upon
@@ -17,19 +20,17 @@ namespace maxmatching {
 		inline Solver(unsigned int arg1, unsigned int arg2): Solver() {};
 		inline virtual ~Solver() {};
 
-		/* Parse a SimpleGraph into the used graph type. */
-		inline void readGraph(SimpleGraph<LClass>* g) {
+		/* Parse a SimpleGraph into the used graph type.
+		 * Solvers may override this to build their graph in bulk. */
+		inline virtual void readGraph(SimpleGraph<LClass>* g) {
 			VClass** vs = new VClass * [g->getVertexCount()];
-			for (auto it = g->vertexLabel.begin(); it != g->vertexLabel.end(); it++) {
-				auto vLabel = *it;
-				auto vIndex = g->indexMap[vLabel];
+			for (auto vIndex : g->order) {
+				auto vLabel = g->vertexLabel[vIndex];
 				VClass* v = new VClass(vLabel);
 				vs[vIndex] = v;
 				this->addVertex(v);
 			}
-			for (auto it = g->vertexLabel.begin(); it != g->vertexLabel.end(); it++) {
-				auto vLabel = *it;
-				auto vIndex = g->indexMap[vLabel];
+			for (auto vIndex : g->order) {
 				auto v = vs[vIndex];
 				auto adjList = g->adjacencies[vIndex];
 				for (auto it2 = adjList->begin(); it2 != adjList->end(); it2++) {
@@ -48,7 +49,15 @@ namespace maxmatching {
 		virtual void calculateMaxMatching() = 0;
 		virtual std::vector<VClass*>* getMatchingRepresentatives() = 0;
 		virtual std::vector<std::pair<LClass, LClass>>* getMatchingLabels() = 0;
+		/* Writes the matching as mate array, read directly from the internal state.
+		 * Vertices are numbered in the order they were added, which is
+		 * SimpleGraph::order for readGraph. mates[k] is the number of the partner
+		 * of the k-th vertex or NoMate. The array must hold an entry for every vertex. */
+		virtual void getMatchingMates(unsigned int* mates) = 0;
 		virtual void reset() = 0;
 		virtual void clearVertices() = 0;
+		/* Prepares static scratch space before the measure starts. Solvers
+		 * using such space hide this with their own version. */
+		inline static void prepareScratch() {};
 	};
 }
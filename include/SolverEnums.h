@@ -8,4 +8,12 @@ namespace maxmatching {
 		MinDegree,
 		MaxDegree
 	};
+
+	/* Describes which heuristic the boost implementation of Edmonds' algorithm
+	 * uses to find an initial matching before searching augmenting paths. */
+	enum BoostInitialMatching {
+		ExtraGreedyInitialMatching,
+		GreedyInitialMatching,
+		EmptyInitialMatching
+	};
 }
\ No newline at end of file
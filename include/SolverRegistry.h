@@ -0,0 +1,30 @@
+#pragma once
+#include <functional>
+#include <map>
+#include <string>
+#include "SimpleGraph.h"
+#include "TypeEnums.h"
+
+namespace maxmatching {
+	class Job;
+
+	/* Runs a single benchmark iteration of the solver selected in the job on a graph.
+	 * Gets the iteration index and seed, stores the size of the matching and returns
+	 * an empty string on success, otherwise the reason of the failure. */
+	typedef std::function<std::string(Job&, SimpleGraph<unsigned int>*, unsigned int, unsigned long, int&)> SolverRunner;
+
+	/* Type erased access to the solvers. Each solver registers an instance of the
+	 * benchmark templates for its solver and vertex class, so a single benchmark
+	 * loop can feed the same graph to all of them. */
+	class SolverRegistry {
+	private:
+		SolverRegistry();
+		~SolverRegistry();
+
+		static std::map<SolverType, SolverRunner> runners;
+	public:
+		static void add(SolverType type, const SolverRunner& runner);
+		/* Returns nullptr, if the solver was not registered */
+		static const SolverRunner* find(SolverType type);
+	};
+}
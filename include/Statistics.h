@@ -1,7 +1,10 @@
 #pragma once
 #include <sstream>
 #include <limits>
+#include <vector>
 #include "Tools.h"
+#include "PerfCounters.h"
+#include "MemoryTracker.h"
 
 #define M_DECLARE(TYPE, FIELD)\
 	static std::vector<TYPE> all ## FIELD;\
@@ -32,7 +35,27 @@
 	M_DECLARE_SETTER(TYPE, FIELD ## Created);\
 	M_DECLARE_SETTER(TYPE, FIELD ## Deleted);
 
+/* Number of recursion depths of the metagraph solvers with an own time column.
+ * Meta solvers in deeper recursion levels are accounted to the last column. */
+#define STATISTICS_META_DEPTHS 4
+
 namespace maxmatching {
+	/* Named phases of the algorithms, which are timed separately.
+	 * Phases are measured inclusively, i.e. shrinking blossoms is also part
+	 * of growing and the meta solve of depth d contains all phases of the
+	 * meta solvers below it. */
+	enum StatisticsPhase {
+		PhaseReadGraph,
+		PhasePreSort,
+		PhaseGreedy,
+		PhaseGrow,
+		PhaseShrink,
+		PhaseApply,
+		/* PhaseMetaSolve + d - 1 is the meta solve in recursion depth d */
+		PhaseMetaSolve,
+		PhaseCount = PhaseMetaSolve + STATISTICS_META_DEPTHS
+	};
+
 	/* Container for a set of static functions to gather data during benchmarks */
 	class Statistics {
 	private:
@@ -45,12 +68,29 @@ namespace maxmatching {
 		static bool timerRunning;
 		static unsigned long startStamp;
 
+		/* Per phase timings in nanoseconds */
+		static std::vector<unsigned long> allPhase[PhaseCount];
+		static unsigned long totPhase[PhaseCount];
+		static unsigned long curPhase[PhaseCount];
+		static unsigned long phaseStamp[PhaseCount];
+		static unsigned int phaseNesting[PhaseCount];
+		static std::string getPhaseName(unsigned int phase);
+		static std::string createEmptyColumns(const std::string& header);
+
 		M_DECLARE_CD(unsigned long, Vert);
 		M_DECLARE_CD(unsigned long, Edge);
 		M_DECLARE_CD(unsigned long, Tree);
 		M_DECLARE_CD(unsigned long, Blos);
 		M_DECLARE(unsigned long, MComp);
 		M_DECLARE(unsigned long, Time);
+		M_DECLARE(unsigned long, Cycles);
+		M_DECLARE(unsigned long, Instructions);
+		M_DECLARE(unsigned long, CacheMisses);
+		M_DECLARE(unsigned long, BranchMisses);
+		M_DECLARE(unsigned long, PeakHeap);
+		M_DECLARE(unsigned long, AllocBytes);
+		M_DECLARE(unsigned long, Allocs);
+		M_DECLARE(unsigned long, PeakRss);
 
 		M_DECLARE(double, I);
 		M_DECLARE(double, RI);
@@ -64,6 +104,9 @@ namespace maxmatching {
 		static void stopMeasure();
 		static void startTimer();
 		static void pauseTimer();
+		static void startPhase(StatisticsPhase phase);
+		static void stopPhase(StatisticsPhase phase);
+		static StatisticsPhase getMetaSolvePhase(unsigned int depth);
 		static std::string createReport();
 
 		M_DECLARE_INC_CD(Vert);
@@ -79,8 +122,23 @@ namespace maxmatching {
 		M_DECLARE_GETTER_CD(unsigned long, Blos);
 		M_DECLARE_GETTER(unsigned long, MComp);
 		M_DECLARE_GETTER(unsigned long, Time);
+		M_DECLARE_GETTER(unsigned long, Cycles);
+		M_DECLARE_GETTER(unsigned long, Instructions);
+		M_DECLARE_GETTER(unsigned long, CacheMisses);
+		M_DECLARE_GETTER(unsigned long, BranchMisses);
+		M_DECLARE_GETTER(unsigned long, PeakHeap);
+		M_DECLARE_GETTER(unsigned long, AllocBytes);
+		M_DECLARE_GETTER(unsigned long, Allocs);
+		M_DECLARE_GETTER(unsigned long, PeakRss);
 		M_DECLARE_GETTER(double, I);
 		M_DECLARE_GETTER(double, RI);
+		static unsigned long getMinPhase(StatisticsPhase phase);
+		static unsigned long getMaxPhase(StatisticsPhase phase);
+		static unsigned long get05PercentilePhase(StatisticsPhase phase);
+		static unsigned long get95PercentilePhase(StatisticsPhase phase);
+		static unsigned long getMedianPhase(StatisticsPhase phase);
+		static double getAveragePhase(StatisticsPhase phase);
+		static unsigned long getCurrentPhase(StatisticsPhase phase);
 
 		M_DECLARE_SETTER(double, I);
 		M_DECLARE_SETTER(double, RI);
@@ -88,6 +146,18 @@ namespace maxmatching {
 		static void sort();
 		static std::string createCsvHeader();
 		static std::string createCsvData();
+		/* Empty values for all columns of the header, used if no measurement succeeded */
+		static std::string createEmptyCsvData();
+		/* One column per value of the current measurement, e.g. for long format tables */
+		static std::string createCurrentCsvHeader();
+		static std::string createCurrentCsvData();
+		static std::string createEmptyCurrentCsvData();
+
+		/* Copies the values of the current measurement into a byte string,
+		 * e.g. to transfer them from a child process. */
+		static std::string serializeCurrent();
+		/* Adds a measurement created by serializeCurrent. Returns false, if the data is malformed. */
+		static bool addSerialized(const std::string& data);
 	};
 }
 
@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "IntStepper.h"
+#include "TypeEnums.h"
+#include "Job.h"
+
+namespace maxmatching {
+	/* Graph source of a suite together with its parameter grid */
+	struct SuiteSource {
+		SourceType type;
+		/* Folder or file relative to the assets folder, only used by file sources */
+		std::string file;
+		IntStepper param1;
+		IntStepper param2;
+	};
+
+	/* Declarative description of a benchmark read from a JSON file, e.g.
+	 * {
+	 *   "seed": 42, "shuffle": true, "iterations": 5, "output": "suite.csv",
+	 *   "sources": [{"source": "-Gr", "args": ["1000:5000:1000", "4"]},
+	 *               {"source": "-f", "args": ["tsplib", "5"]}],
+	 *   "solvers": [{"solver": "-mgqpt", "args": ["0:2", "1"]}, {"solver": "-eb"}]
+	 * }
+	 * Sources and solvers use the same flags and argument syntax as the command line.
+	 * Every instance of every source is benchmarked with all solvers. */
+	class Suite {
+	public:
+		unsigned long seed;
+		bool shuffle;
+		unsigned int iterations;
+		std::string output;
+		std::vector<SuiteSource> sources;
+		/* All solvers with their argument grids expanded */
+		std::vector<SolverConfig> solvers;
+
+		Suite();
+		~Suite();
+
+		/* Reads the suite file. Returns false and sets the error message, if it is malformed. */
+		bool load(const std::string& file, std::string& error);
+	};
+}
@@ -24,11 +24,12 @@
 #define L_MAKE_STATIC(NAME, FUNCDEFS) L_MAKE_STATIC_T(,NAME,FUNCDEFS)
 
 /* This file contains static helper functions for getting current timestamps
- * and working with strings and vectors. */
+ * and working with strings and vectors, as well as running tasks in parallel. */
 
 namespace maxmatching {
 	L_MAKE_STATIC(Time, \
-		static unsigned long currentTimeMillis();
+		static unsigned long currentTimeMillis(); \
+		static unsigned long currentTimeNanos();
 	);
 
 	L_MAKE_STATIC(Strings, \
@@ -63,11 +64,45 @@ namespace maxmatching {
 	static void getContainedFiles(const std::string& dir, const std::string& pattern, std::vector<std::string>& ret);
 	static void makePath(const std::string& dir);
 	static void makePathToFile(const std::string& file);
-	static std::string inputFileToBufferFile(const std::string& inputFile, const int& nNeighbors);
 	);
 
-	L_MAKE_STATIC(Random,
-		static std::mt19937_64* makeRandom(const long& seed);
+	/* Counter based random number generator (Philox4x32-10 from Salmon et al.,
+	 * "Parallel Random Numbers: As Easy as 1, 2, 3"). The seed is the key and the counter
+	 * holds the stream id and the position within the stream, so every stream of a seed
+	 * is independent and can be created anywhere without drawing from another generator.
+	 * Threads or blocks of vertices use their own streams, which makes results independent
+	 * of the number of threads. Satisfies the UniformRandomBitGenerator requirements. */
+	class RandomStream {
+	private:
+		unsigned long seed;
+		unsigned long stream;
+		unsigned long position;
+		unsigned long buffer[2];
+		unsigned int buffered;
+
+		void generateBlock();
+	public:
+		typedef unsigned long result_type;
+
+		RandomStream(unsigned long seed, unsigned long stream);
+
+		static constexpr result_type min() {
+			return 0;
+		}
+		static constexpr result_type max() {
+			return ~0ul;
+		}
+		inline result_type operator()() {
+			if (this->buffered == 0) {
+				this->generateBlock();
+			}
+			return this->buffer[--this->buffered];
+		}
+	};
+
+	L_MAKE_STATIC(Parallel,
+		static unsigned int getThreadCount();
+		static void forEach(unsigned long nTasks, const std::function<void(unsigned long)>& task);
 	);
 }
 
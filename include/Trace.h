@@ -0,0 +1,50 @@
+#pragma once
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace maxmatching {
+	/* Per round data of a metagraph solver in one recursion depth */
+	struct TraceRound {
+		unsigned int depth;
+		unsigned long round;
+		unsigned long nUnmatched;
+		/* Number of trees in each layer of the grow queue stack */
+		std::vector<unsigned int> growTrees;
+		/* Number of trees in each layer of the frustrated shrinkable stack */
+		std::vector<unsigned int> shrinkableTrees;
+		unsigned int frustratedTrees;
+		unsigned int metaVertices;
+		unsigned int metaEdges;
+		unsigned int metaMatching;
+		unsigned long blossomsCreated;
+		unsigned long growNs;
+		unsigned long shrinkNs;
+		unsigned long metaSolveNs;
+		unsigned long applyNs;
+	};
+
+	/* Structured trace sink writing one JSON object per line. Each benchmark
+	 * iteration starts a run record, followed by the round records of all
+	 * solvers in all recursion depths of that iteration. */
+	class Trace {
+	private:
+		Trace();
+		~Trace();
+
+		static std::ofstream* out;
+		static unsigned long runCtr;
+
+		static void writeString(std::ostream& stream, const std::string& str);
+		static void writeArray(std::ostream& stream, const std::vector<unsigned int>& values);
+	public:
+		static void open(const std::string& file);
+		static void close();
+		static void flush();
+		static bool isEnabled();
+
+		static void startRun(const std::string& source, const std::string& solver, unsigned int solverArg1, unsigned int solverArg2, unsigned long seed, unsigned int iteration);
+		static void writeRound(const TraceRound& round);
+	};
+}
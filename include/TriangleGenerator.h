@@ -1,42 +1,74 @@
 #pragma once
-#include "SimpleGraph.h"
-#ifdef HAS_FADE
-#include <Fade_2D.h>
-#endif
 #include <vector>
-#include <map>
+#include "SimpleGraph.h"
+#include "Tools.h"
 
 namespace maxmatching {
+	/* Random Delaunay triangulations of uniformly distributed points in the plane.
+	 * Points have integer coordinates below 2^COORD_BITS, so orientation and incircle
+	 * tests are exact in 64 and 128 bit arithmetic and degenerate inputs need no special care.
+	 * The points are inserted in the order of a Hilbert curve with the Bowyer-Watson algorithm:
+	 * A walk from the last created triangle finds a triangle in conflict with the new point,
+	 * all triangles whose circumcircle contains it are removed and their hole is filled with
+	 * triangles around the point. The convex hull is closed by ghost triangles with an infinite
+	 * vertex, so there is no super triangle and points outside the hull need no special case.
+	 * Vertices are the indices of the points, so no coordinate lookup is needed for the edges. */
 	class TriangleGenerator {
 	private:
-		typedef std::map<double, unsigned int> yMap;
-		typedef std::map<double, yMap> xMap;
-
-		template <typename K, typename V>
-		bool mapHasKey(std::map<K, V> &m, K &k) {
-			return m.count(k) > 0;
-		}
-		template <typename K, typename V>
-		V& mapGet(std::map<K, V> &m, K &k, V &fallback) {
-			auto it = m.find(k);
-			if (it != m.end()) {
-				return (*it).second;
-			}
-			return fallback;
-		}
-
-		inline yMap& xMapGet(xMap &m, double &k, yMap &y) {
-			return mapGet<double, yMap>(m,k,y);
-		}
-		inline unsigned int& yMapGet(yMap &m, double &k, unsigned int &f) {
-			return mapGet<double, unsigned int>(m,k,f);
-		}
-		
+		static const unsigned int COORD_BITS = 28;
+		static const unsigned int INFINITE = ~0u;
+		static const unsigned int DEAD = ~0u - 1;
+
+		struct Point {
+			long x;
+			long y;
+		};
+
+		/* Corners in counterclockwise order, neighbor i lies opposite of corner i */
+		struct Triangle {
+			unsigned int v[3];
+			unsigned int n[3];
+		};
+
+		/* Edge a->b on the boundary of the cavity, which is edge side of the outer triangle */
+		struct Edge {
+			unsigned int a;
+			unsigned int b;
+			unsigned int outer;
+			unsigned int side;
+		};
+
+		std::vector<Point> points;
+		std::vector<Triangle> triangles;
+		std::vector<unsigned int> freeTriangles;
+		/* Stamp of the insertion, that found a triangle in conflict or not in conflict */
+		std::vector<unsigned int> conflictStamp;
+		std::vector<unsigned int> noConflictStamp;
+		/* New triangle of the current insertion starting at a cavity boundary vertex */
+		std::vector<unsigned int> startingAt;
+		/* Triangles removed by the current insertion, afterwards the ones created by it */
+		std::vector<unsigned int> cavity;
+		std::vector<Edge> boundary;
+		unsigned int stamp;
+		unsigned int last;
+
+		static unsigned long hilbertKey(unsigned long x, unsigned long y);
+		/* Positive, if c lies left of the line from a to b */
+		static long orient(const Point& a, const Point& b, const Point& c);
+		/* True, if d lies inside the circumcircle of the counterclockwise triangle abc */
+		static bool inCircle(const Point& a, const Point& b, const Point& c, const Point& d);
+
+		void drawPoints(unsigned int nPoints, unsigned long seed, std::vector<unsigned int>& order);
+		bool inConflict(unsigned int t, unsigned int p) const;
+		unsigned int newTriangle(unsigned int a, unsigned int b, unsigned int c);
+		void initialize(unsigned int a, unsigned int b, unsigned int c);
+		unsigned int locate(unsigned int p) const;
+		void insert(unsigned int p);
 	public:
 		TriangleGenerator();
 		~TriangleGenerator();
 
-		SimpleGraph<unsigned int>* generate(unsigned int nPoints, std::mt19937_64 &rgen);
+		SimpleGraph<unsigned int>* generate(unsigned int nPoints, unsigned long seed);
 	};
 
 }
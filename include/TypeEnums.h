@@ -24,14 +24,19 @@ namespace maxmatching {
 		Filesystem,
 		RandomBoost,
 		RandomDimacs,
-#ifdef HAS_FADE
 		RandomTriangle,
-#endif
 		RandomEuclid2d,
 		RandomEuclid3d,
 		RandomEuclid10d,
 		RandomEuclid20d,
+		RandomRMat,
+		RandomBarabasiAlbert,
+		RandomRegular,
+		RandomGrid2d,
+		RandomGrid3d,
 		WorstCaseGabow,
+		NestedBlossoms,
+		BlossomChain,
 		TriangleSeriesA,
 		TriangleSeriesB,
 		HoneyCombs,
@@ -61,11 +61,7 @@ namespace norm {
 	/* Returns the receptacle of the representant in the disjoint-set data structure */
 	template <class Label>
 	MVertex<Label>* MCherryBlossom<Label>::getReceptacle() {
-		if (this->parentBlossom == nullptr) {
-			return this->receptacle;
-		} else {
-			return this->getReference()->getReceptacle();
-		}
+		return this->getReference()->receptacle;
 	}
 
 	/* Adds a vertex to the cherry blossoms corolla.
@@ -75,7 +71,7 @@ namespace norm {
 		if (v->getImmediateBlossom() != nullptr) {
 			v->getImmediateBlossom()->remove(v);
 		}
-		this->vertices.append(&v->listElemBlossomVertices);
+		this->getReference()->vertices.append(&v->listElemBlossomVertices);
 		v->setContainingBlossom(this);
 	}
 
@@ -153,15 +149,19 @@ namespace norm {
 		newReceptacle->bearingBlossoms.append(&this->listElement);
 	}
 
+	/* First element of the list of all vertices in the corolla */
+	template <class Label>
+	ListElement<MVertex<Label>>* MCherryBlossom<Label>::getFirstVertex() {
+		return this->getReference()->vertices.getFirstElement();
+	}
+
 	/* Helper method to iterate over all vertices */
 	template <class Label>
-	void MCherryBlossom<Label>::foreachVertex(const std::function<void(MVertex<Label>*)>& fun) {
-		for (auto el = this->vertices.getFirstElement(); el != nullptr; el = el->nxtElem) {
+	template <class F>
+	void MCherryBlossom<Label>::foreachVertex(F fun) {
+		for (auto el = this->getFirstVertex(); el != nullptr; el = el->nxtElem) {
 			fun(el->value);
 		}
-		for (auto el = this->childBlossoms.getFirstElement(); el != nullptr; el = el->nxtElem) {
-			el->value->foreachVertex(fun);
-		}
 	}
 
 	/* Basically the "join"/"union" in the disjoint-set data structure */
@@ -170,25 +170,25 @@ namespace norm {
 		DEBUG("Invoking blossom merge between "
 			<< (this->getReceptacle() == nullptr ? 0 : this->getReceptacle()->id) << " and "
 			<< (child->getReceptacle() == nullptr ? 0 : child->getReceptacle()->id) << "\n");
-		/* Always merge with the root in the disjoint-set forest */
-		if (this != this->getReference()) {
-			this->getReference()->merge(child);
-		} else {
-			child = child->getReference();
-			/* If the other blossoms tree in the disjoint-set data
-			 * structure is bigger, merge into this blossom instead.
-			 * -> Union-by-size! */
-			if (child->complexity > this->complexity) {
-				child->setReceptacle(this->receptacle);
-				child->merge(this);
-			} else {
-				child->setReceptacle(nullptr);
-				this->childBlossoms.append(&child->childElement);
-				child->parentBlossom = this;
-				this->complexity += child->complexity;
-				Statistics::processMComp(this->complexity);
-			}
+		/* Always merge the roots in the disjoint-set forest */
+		MCherryBlossom<Label>* root = this->getReference();
+		child = child->getReference();
+		if (root == child) {
+			return;
 		}
+		/* If the other blossoms tree in the disjoint-set data
+		 * structure is bigger, merge into that blossom instead.
+		 * -> Union-by-size! */
+		if (child->complexity > root->complexity) {
+			child->setReceptacle(root->receptacle);
+			std::swap(root, child);
+		}
+		child->setReceptacle(nullptr);
+		root->childBlossoms.append(&child->childElement);
+		child->parentBlossom = root;
+		root->complexity += child->complexity;
+		root->vertices.splice(&child->vertices);
+		Statistics::processMComp(root->complexity);
 	}
 
 	/* Removes a child from the disjoint-set data structure */
@@ -202,12 +202,15 @@ namespace norm {
 	/* Returns the representant of this blossom in the disjoint-set data structure */
 	template <class Label>
 	MCherryBlossom<Label>* MCherryBlossom<Label>::getReference() {
-		if (this->parentBlossom == nullptr) {
-			return this;
-		} else {
-			this->parentBlossom = this->parentBlossom->getReference();
-			return this->parentBlossom;
+		MCherryBlossom<Label>* ret = this;
+		/* Path halving: every visited blossom skips its parent */
+		while (ret->parentBlossom != nullptr) {
+			if (ret->parentBlossom->parentBlossom != nullptr) {
+				ret->parentBlossom = ret->parentBlossom->parentBlossom;
+			}
+			ret = ret->parentBlossom;
 		}
+		return ret;
 	}
 
 	template <class Label>
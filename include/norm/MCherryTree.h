@@ -9,6 +9,7 @@ namespace norm {
 
 #include <fstream>
 #include <sstream>
+#include <vector>
 #include <functional>
 #include "Debug.h"
 #include "Statistics.h"
@@ -22,16 +23,59 @@ namespace norm {
 	template <class Label>
 	class MCherryTree {
 	private:
-		/* Counter to enumerate debug prints */
-		static unsigned int printCtr;
 		/* Internal debug method */
 		void recursivePrintNode(MVertex<Label>* v, const std::string& prefix, std::stringstream& stream);
-		/* Adopts a blossom with a receptacle, that has just been added to the tree */
-		void adoptBlossom(MCherryBlossom<Label>* blossom);
+		/* Steps of the worklist in add. Adding a vertex adopts the blossoms borne by its new
+		 * partner, adds its old children and then its old parent. Adopting a blossom claims
+		 * its corolla, adopts the blossoms borne by the corolla and adds their children.
+		 * The Done steps continue a loop after the nested frame has been finished. */
+		enum AddStep {
+			AddVertex,
+			AddBorneBlossom,
+			AddBorneBlossomDone,
+			AddOldChild,
+			AddOldChildDone,
+			AddOldParent,
+			AdoptBlossom,
+			AdoptVertex,
+			AdoptBorneBlossom,
+			AdoptBorneBlossomDone,
+			AdoptChild,
+			AdoptChildDone
+		};
+		/* Frame of the worklist in add, replacing a recursive call */
+		struct AddFrame {
+			AddStep step;
+			/* Edge to the added vertex */
+			HalfEdge<Label>* edge;
+			/* Adopted blossom */
+			MCherryBlossom<Label>* blossom;
+			/* Positions of the loops over the corolla, the borne blossoms and the odd children */
+			ListElement<MVertex<Label>>* vertexEl;
+			ListElement<MCherryBlossom<Label>>* blossomEl;
+			ListElement<HalfEdge<Label>>* edgeEl;
+
+			AddFrame(AddStep step, HalfEdge<Label>* edge, MCherryBlossom<Label>* blossom)
+				: step(step)
+				, edge(edge)
+				, blossom(blossom)
+				, vertexEl(nullptr)
+				, blossomEl(nullptr)
+				, edgeEl(nullptr) {}
+		};
+		/* Capacity of the scratch space at the start of every run */
+		static const unsigned int SCRATCH_SIZE = 1 << 12;
+		/* Worklist of add and the vertices of remove and updateLevelBelow, shared by all
+		 * trees, so deep trees neither overflow the call stack nor allocate per call */
+		static std::vector<AddFrame> addStack;
+		static std::vector<MVertex<Label>*> vertexStack;
 		/* Internal debug flag.
 		 * Printing a tree, while the structure is being reformed is unsafe. */
 		bool consistent;
 	public:
+		/* Frees the scratch space grown by the last run and reserves the initial capacity.
+		 * Called before the measure starts, so every run is charged the same. */
+		static void resetScratch();
 		/* Root of the tree */
 		MVertex<Label>* root;
 		/* Number of vertices in the tree */
@@ -55,7 +99,6 @@ namespace norm {
 		List<MVertex<Label>>* getVertices();
 
 		void logTree();
-		void printTree();
 	};
 }
 }
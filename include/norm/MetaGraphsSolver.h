@@ -19,6 +19,9 @@ namespace norm {
 	private:
 		/* List of all vertices. Basically the graph representation. */
 		std::vector<MVertex<Label>*> vertices;
+		/* Position of every vertex in the order it was added, indexed by its id relative
+		 * to the smallest id. Empty as long as preSort did not renumber the vertices. */
+		std::vector<unsigned int> positions;
 		/* List of remaining search trees. */
 		List<MCherryTree<Label>> remainingTrees;
 		/* GrowQueue containing all vertices, from which growing is possible */
@@ -33,8 +36,11 @@ namespace norm {
 		/* Coefficients for benchmarking */
 		double I;
 		double RI;
+		/* Recursion depth of this solver. The solver for the base graph has depth 0. */
+		unsigned int depth;
 
 		void preSort();
+		unsigned int getPosition(MVertex<Label>* v, unsigned int firstId);
 		void greedyPreSolve();
 	public:
 		/* Enum to describe which strategy to use for sorting the vertices
@@ -57,6 +63,7 @@ namespace norm {
 		void addMetaEdge(MVertex<Label>* u, MVertex<Label>* v, HalfEdge<Label>* label);
 		std::vector<HalfEdge<Label>*>* getMatching();
 		std::vector<MVertex<Label>*>* getMatchingRepresentatives();
+		void getMatchingMates(unsigned int* mates);
 		std::vector<std::pair<Label, Label>>* getMatchingLabels();
 		void reset();
 
@@ -71,6 +78,7 @@ namespace norm {
 		double getRI();
 
 		void clearVertices();
+		static void prepareScratch();
 	};
 }
 }
@@ -7,7 +7,7 @@ namespace qpt {
 }
 }
 
-#include <functional>
+#include <utility>
 #include "Debug.h"
 #include "Statistics.h"
 #include "List.h"
@@ -21,7 +21,8 @@ namespace qpt {
 	private:
 		/* Receptacle of the cherry blossom */
 		MVertex<Label>* receptacle;
-		/* List of vertices in the corolla */
+		/* List of vertices in the corolla. Merging moves the vertices of the child to the
+		 * representant, so only the list of the representant is in use. */
 		List<MVertex<Label>> vertices;
 		/* Parent in the disjoint-set data structure */
 		MCherryBlossom<Label>* parentBlossom;
@@ -30,7 +31,7 @@ namespace qpt {
 		/* Level of this blossom */
 		int level;
 	public:
-		/* List of children in the disjoint-set data structure */
+		/* List of children in the disjoint-set data structure, which owns them */
 		List<MCherryBlossom<Label>> childBlossoms;
 		/* ListElement for the children lists in the disjoint-set data structure
 		 * Necessary for O(1) deletion */
@@ -47,7 +48,9 @@ namespace qpt {
 		void rotate(MVertex<Label>* newReceptacle);
 		void setReceptacle(MVertex<Label>* newReceptacle);
 		MVertex<Label>* getReceptacle();
-		void foreachVertex(const std::function<void(MVertex<Label>*)>& fun);
+		ListElement<MVertex<Label>>* getFirstVertex();
+		template <class F>
+		void foreachVertex(F fun);
 		void merge(MCherryBlossom<Label>* child);
 		void remove(MCherryBlossom<Label>* child);
 		MCherryBlossom<Label>* getReference();
@@ -7,6 +7,7 @@
 #include "Debug.h"
 #include "Solver.h"
 #include "Statistics.h"
+#include "Trace.h"
 #include "List.h"
 #include "ListElement.h"
 #include "qpt/MCherryTree.h"
@@ -20,6 +21,9 @@ namespace qpt {
 	private:
 		/* List of all vertices. Basically the graph representation. */
 		std::vector<MVertex<Label>*> vertices;
+		/* Position of every vertex in the order it was added, indexed by its id relative
+		 * to the smallest id. Empty as long as preSort did not renumber the vertices. */
+		std::vector<unsigned int> positions;
 		/* List of frustrated search trees. */
 		List<MCherryTree<Label>> frustratedTrees;
 		/* Stores all trees, from which growing is possible, in layers by number of meta edges */
@@ -44,8 +48,11 @@ namespace qpt {
 		unsigned int currentMinNeighborsShrinking;
 		unsigned long nUnmatchedNodes;
 		unsigned int metaEdges;
+		/* Recursion depth of this solver. The solver for the base graph has depth 0. */
+		unsigned int depth;
 
 		void preSort();
+		unsigned int getPosition(MVertex<Label>* v, unsigned int firstId);
 		void greedyPreSolve();
 		void storeInCorrectList(ListElement<MCherryTree<Label>>* treeEl);
 	public:
@@ -66,6 +73,7 @@ namespace qpt {
 		void addMetaEdge(MVertex<Label>* u, MVertex<Label>* v, HalfEdge<Label>* label);
 		std::vector<HalfEdge<Label>*>* getMatching();
 		std::vector<MVertex<Label>*>* getMatchingRepresentatives();
+		void getMatchingMates(unsigned int* mates);
 		std::vector<std::pair<Label, Label>>* getMatchingLabels();
 		void reset();
 
@@ -81,6 +89,7 @@ namespace qpt {
 		double getRI();
 
 		void clearVertices();
+		static void prepareScratch();
 	};
 }
 }
@@ -23,6 +23,7 @@ namespace qpt {
 		, currentMinNeighborsShrinking(0)
 		, nUnmatchedNodes(0)
 		, metaEdges(0)
+		, depth(0)
 		, preSortStrat(MinDegree) {
 		growQueueStack = new List<MCherryTree<Label>> * [maxMetaNeighbors + 1];
 		frustratedShrinkableStack = new List<MCherryTree<Label>> * [maxMetaNeighborsShrinking + 1];
@@ -54,6 +55,12 @@ namespace qpt {
 	}
 
 	/* Clear the vertex list and also delete all contained vertices */
+	/* The trees share their scratch space across solvers */
+	template <class Label>
+	void MetaGraphsSolver<Label>::prepareScratch() {
+		MCherryTree<Label>::resetScratch();
+	}
+
 	template <class Label>
 	void MetaGraphsSolver<Label>::clearVertices() {
 		for (MVertex<Label>* v : this->vertices) {
@@ -61,6 +68,7 @@ namespace qpt {
 		}
 		this->vertices.clear();
 		this->vertices.shrink_to_fit();
+		this->positions.clear();
 	}
 
 	/* Sorts the vertices according to the defined presort strategy */
@@ -103,6 +111,13 @@ namespace qpt {
 				}
 				break;
 		}
+		/* Remember the positions, since the ids are the only link to them */
+		std::vector<unsigned int> sortedPositions(this->vertices.size());
+		for (unsigned int i = 0; i < this->vertices.size(); i++) {
+			unsigned int id = this->vertices[i]->id - minId;
+			sortedPositions[i] = this->positions.empty() ? id : this->positions[id];
+		}
+		this->positions.swap(sortedPositions);
 		for (unsigned int i = 0; i < this->vertices.size(); i++) {
 			MVertex<Label>* v = this->vertices[i];
 			v->id = minId + i;
@@ -219,6 +234,28 @@ namespace qpt {
 		return ret;
 	}
 
+	template <class Label>
+	unsigned int MetaGraphsSolver<Label>::getPosition(MVertex<Label>* v, unsigned int firstId) {
+		unsigned int id = v->id - firstId;
+		return this->positions.empty() ? id : this->positions[id];
+	}
+
+	/* The ids of the vertices are consecutive, preSort keeps the positions they were added at */
+	template <class Label>
+	void MetaGraphsSolver<Label>::getMatchingMates(unsigned int* mates) {
+		if (this->vertices.empty()) {
+			return;
+		}
+		unsigned int firstId = this->vertices[0]->id;
+		for (auto v : this->vertices) {
+			firstId = std::min(firstId, v->id);
+		}
+		for (auto v : this->vertices) {
+			auto w = v->getMatchingPartner();
+			mates[this->getPosition(v, firstId)] = w != nullptr ? this->getPosition(w, firstId) : NoMate;
+		}
+	}
+
 	template <class Label>
 	void MetaGraphsSolver<Label>::reset() {
 		for (unsigned int i = 0; i <= this->maxMetaNeighbors; i++) {
@@ -268,9 +305,13 @@ namespace qpt {
 			reset();
 		}
 		DEBUG("\nEntering new meta graph calculation\n");
+		Statistics::startPhase(PhasePreSort);
 		preSort();
+		Statistics::stopPhase(PhasePreSort);
 		/* Start with a fast approximation */
+		Statistics::startPhase(PhaseGreedy);
 		greedyPreSolve();
+		Statistics::stopPhase(PhaseGreedy);
 		DEBUG("Finished greedy approximation\n");
 		/* Initialize problem */
 		this->nUnmatchedNodes = 0;
@@ -286,6 +327,8 @@ namespace qpt {
 		}
 		/* Loop until no progress is made, i.e. no additional matchings are found */
 		//bool keepRunning = this->remainingTrees.getSize() > 1;
+		const bool tracing = Trace::isEnabled();
+		unsigned long nRounds = 0;
 		while (this->nUnmatchedNodes > 1 && ((this->growQueueStack[0]->getSize() > 0) || (this->frustratedShrinkableStack[0]->getSize() > 0))) {
 			//int nRemainingTrees = this->remainingTrees.getSize();
 			//this->metaEdgeMatrix.resize(nRemainingTrees * (nRemainingTrees - 1) / 2, false);
@@ -300,6 +343,17 @@ namespace qpt {
 			this->currentMinNeighbors = 0;
 			this->currentMinNeighborsShrinking = 0;
 			this->metaEdges = 0;
+			TraceRound traceRound = TraceRound();
+			if (tracing) {
+				traceRound.depth = this->depth;
+				traceRound.round = nRounds;
+				traceRound.nUnmatched = this->nUnmatchedNodes;
+				traceRound.blossomsCreated = Statistics::getCurrentBlosCreated();
+				traceRound.growNs = Statistics::getCurrentPhase(PhaseGrow);
+				traceRound.shrinkNs = Statistics::getCurrentPhase(PhaseShrink);
+			}
+			nRounds++;
+			Statistics::startPhase(PhaseGrow);
 			ListElement<MCherryTree<Label>> * treeEl = this->getGrowableTreeEl();
 			while (treeEl != nullptr) {
 				MVertex<Label>* v = treeEl->value->growQueue.popElem()->value;
@@ -307,8 +361,24 @@ namespace qpt {
 				this->storeInCorrectList(treeEl);
 				treeEl = this->getGrowableTreeEl();
 			}
+			Statistics::stopPhase(PhaseGrow);
+			if (tracing) {
+				/* Growing contains no meta solvers, so the differences are exact for this depth */
+				traceRound.blossomsCreated = Statistics::getCurrentBlosCreated() - traceRound.blossomsCreated;
+				traceRound.growNs = Statistics::getCurrentPhase(PhaseGrow) - traceRound.growNs;
+				traceRound.shrinkNs = Statistics::getCurrentPhase(PhaseShrink) - traceRound.shrinkNs;
+				for (unsigned int i = 0; i <= this->maxMetaNeighbors; i++) {
+					traceRound.growTrees.push_back(this->growQueueStack[i]->getSize());
+				}
+				for (unsigned int i = 0; i <= this->maxMetaNeighborsShrinking; i++) {
+					traceRound.shrinkableTrees.push_back(this->frustratedShrinkableStack[i]->getSize());
+				}
+				traceRound.frustratedTrees = this->frustratedTrees.getSize();
+				traceRound.metaEdges = this->metaEdges;
+			}
 			/* Create a solver for the metagraph and initialize it */
 			MetaGraphsSolver<Label> metaSolver(this->maxMetaNeighbors, this->maxMetaNeighborsShrinking);
+			metaSolver.depth = this->depth + 1;
 			std::function<void(List<MCherryTree<Label>>*)> useMetaVertices = [&metaSolver](List<MCherryTree<Label>> * tList) {
 				for (ListElement<MCherryTree<Label>>* el = tList->getFirstElement(); el != nullptr; el = el->nxtElem) {
 					MVertex<Label>* mv = el->value->metaVertex;
@@ -343,12 +413,27 @@ namespace qpt {
 			}
 			//std::cout << "Meta solver has " << metaSolver.vertices.size() << " vertices\n";
 			/* Empty meta vertices means no extended matching */
+			traceRound.metaVertices = metaSolver.vertices.size();
 			if (metaSolver.vertices.size() > 0) {
+				unsigned long metaSolveStamp = tracing ? Time::currentTimeNanos() : 0;
+				Statistics::startPhase(Statistics::getMetaSolvePhase(metaSolver.depth));
 				metaSolver.calculateMaxMatching();
+				Statistics::stopPhase(Statistics::getMetaSolvePhase(metaSolver.depth));
+				if (tracing) {
+					traceRound.metaSolveNs = Time::currentTimeNanos() - metaSolveStamp;
+					traceRound.applyNs = Statistics::getCurrentPhase(PhaseApply);
+				}
 				this->I += metaSolver.getI() * .5;
 				this->RI += metaSolver.getRI() * metaSolver.getVertices().size() / this->getVertices().size();
 				std::vector<MVertex<Label>*>* matching = metaSolver.getMatchingRepresentatives();
+				Statistics::startPhase(PhaseApply);
 				this->applyMetaMatching(matching);
+				Statistics::stopPhase(PhaseApply);
+				if (tracing) {
+					traceRound.metaMatching = matching->size();
+					traceRound.applyNs = Statistics::getCurrentPhase(PhaseApply) - traceRound.applyNs;
+					Trace::writeRound(traceRound);
+				}
 				delete(matching);
 				/* Exit if there are 0 possibly growable trees */
 				if ((this->growQueueStack[0]->getSize() > 0) || (this->frustratedShrinkableStack[0]->getSize() > 0)) {
@@ -370,6 +455,9 @@ namespace qpt {
 					this->nUnmatchedNodes = newIds;
 				}
 			} else {
+				if (tracing) {
+					Trace::writeRound(traceRound);
+				}
 				break;
 			}
 		}
@@ -392,9 +480,11 @@ namespace qpt {
 		while (this->currentMinNeighborsShrinking < this->maxMetaNeighborsShrinking) {
 			if (!this->frustratedShrinkableStack[this->currentMinNeighborsShrinking]->isEmpty()) {
 				ListElement<MCherryTree<Label>>* treeEl = this->frustratedShrinkableStack[this->currentMinNeighborsShrinking]->popElem();
+				Statistics::startPhase(PhaseShrink);
 				while (treeEl->value->growQueue.isEmpty() && treeEl->value->canCreateBlossom()) {
 					treeEl->value->makeBlossom();
 				}
+				Statistics::stopPhase(PhaseShrink);
 				if (!treeEl->value->growQueue.isEmpty()) {
 					/* Update min neighbors, since we reintroduce a tree to the normal grow stack */
 					this->currentMinNeighbors = this->currentMinNeighborsShrinking;
@@ -460,6 +550,7 @@ namespace qpt {
 			tw->rotate(w);
 			v->setMatchingPartner(vw);
 			w->setMatchingPartner(vw->inverse);
+			TRACE_EVENT(EventAugment, v->id, w->id);
 			tv->listElem.containingList->remove(&tv->listElem);
 			tw->listElem.containingList->remove(&tw->listElem);
 			twinTrees.append(&tv->listElem);
@@ -480,8 +571,8 @@ namespace qpt {
 		List<MVertex<Label>> vs;
 		while (!twinTrees->isEmpty()) {
 			MCherryTree<Label>* tree = twinTrees->popElem()->value;
-			tree->printTree();
 			List<MVertex<Label>>* lvs = tree->getVertices();
+			TRACE_EVENT(EventDissolve, tree->root->id, lvs->getSize());
 			/* Remove references to the old tree */
 			while (!lvs->isEmpty()) {
 				MVertex<Label>* s = lvs->pop();
@@ -529,7 +620,6 @@ namespace qpt {
 						this->growQueueStack[0]->append(&newTree->listElem);
 					}
 					newTree->updateLevelBelow(s->getMatchingPartner());
-					newTree->printTree();
 					break;
 				}
 			}
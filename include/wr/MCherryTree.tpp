@@ -2,6 +2,20 @@
 
 namespace maxmatching {
 namespace wr {
+
+	template <class Label>
+	std::vector<typename MCherryTree<Label>::AddFrame> MCherryTree<Label>::addStack;
+	template <class Label>
+	std::vector<MVertex<Label>*> MCherryTree<Label>::vertexStack;
+
+	template <class Label>
+	void MCherryTree<Label>::resetScratch() {
+		std::vector<AddFrame>().swap(MCherryTree<Label>::addStack);
+		std::vector<MVertex<Label>*>().swap(MCherryTree<Label>::vertexStack);
+		MCherryTree<Label>::addStack.reserve(MCherryTree<Label>::SCRATCH_SIZE);
+		MCherryTree<Label>::vertexStack.reserve(MCherryTree<Label>::SCRATCH_SIZE);
+	}
+
 	template <class Label>
 	MCherryTree<Label>::MCherryTree(MVertex<Label>* root)
 		: consistent(true)
@@ -16,7 +30,6 @@ namespace wr {
 	template <class Label>
 	MCherryTree<Label>::~MCherryTree() {
 		DEBUG("Deleting tree " << (this->root == nullptr ? 0 : this->root->id) << "@" << this << "\n");
-		this->printTree();
 		/* Prevent any prints during deletion */
 		consistent = false;
 		/* Remove all vertices from the tree, so the vertices can't reference the tree anymore. */
@@ -49,7 +62,7 @@ namespace wr {
 			DEBUG("MVertex " << newRoot->id << " is in blossom " << newRoot->getContainingBlossom()->getReceptacle()->id << "\n");
 		}
 #endif
-		this->printTree();
+		TRACE_EVENT(EventRotate, this->root->id, newRoot->id);
 		bool consistencyUpdate = this->consistent;
 		this->consistent = false;
 		List<HalfEdge<Label>>* l = new List<HalfEdge<Label>>();
@@ -122,115 +135,183 @@ namespace wr {
 		 * be commented back in! */
 		 //this->updateLevel();
 		this->consistent = consistencyUpdate;
-		this->printTree();
-	}
-
-	/* This is to be called, if the receptacle has just been added and the other vertices
-	* of the corolla are in no tree yet. It claims the corolla for this tree and manages
-	* the children of the new nodes. */
-	template <class Label>
-	void MCherryTree<Label>::adoptBlossom(MCherryBlossom<Label> * blossom) {
-		DEBUG("Adopting blossom " << blossom->getReceptacle()->id << "\n");
-		bool consistencyUpdate = this->consistent;
-		this->consistent = false;
-		auto fun = [this, blossom](MVertex<Label> * v)->void {
-			DEBUG("Visiting " << v->id << "\n");
-			v->setContainingTree(this);
-			v->enqueue();
-			this->size += 1;
-			/* Adopt further blossoms */
-			for (auto el = v->bearingBlossoms.getFirstElement(); el != nullptr; el = el->nxtElem) {
-				this->adoptBlossom(el->value->getReference());
-			}
-			/* Add children to the tree */
-			for (auto elem = v->oddChildren.getFirstElement(); elem != nullptr; elem = elem->nxtElem) {
-				HalfEdge<Label>* e = elem->value;
-				MVertex<Label>* child = e->end;
-				if (child->getContainingBlossom() != blossom) {
-					this->add(e);
-				}
-			}
-		};
-		blossom->updateLevel();
-		blossom->foreachVertex(fun);
-		this->consistent = consistencyUpdate;
 	}
 
 	/* Adds a vertex into the tree along the given edge.
 	 * Also uses as much of potential old tree structure as possible
-	 * given the information stored in the vertices. */
+	 * given the information stored in the vertices.
+	 * Instead of calling itself for the old children and parents and for adopted
+	 * blossoms, it works on a stack of frames, which continue their loops in the
+	 * same order as the recursive calls did. */
 	template <class Label>
 	void MCherryTree<Label>::add(HalfEdge<Label> * parentToChild) {
-#ifdef DEBUG_F
-		MVertex<Label>* parent = parentToChild->start;
-#endif
-		MVertex<Label>* child = parentToChild->end;
-		/* Sanity check */
-		if (child->getContainingTree() != nullptr) {
-			return;
-		}
 		bool consistencyUpdate = this->consistent;
 		this->consistent = false;
-		/* Update references for containment in tree */
-		MVertex<Label>* newPartner = child->getMatchingPartner();
-		DEBUG("Adding vertices "
-			<< (parent == nullptr ? 0 : parent->id)
-			<< " -> "
-			<< (child == nullptr ? 0 : child->id)
-			<< " -> "
-			<< (newPartner == nullptr ? 0 : newPartner->id) << "\n");
-		child->setEvenParent(parentToChild->inverse);
-		child->setContainingTree(this);
-		newPartner->setContainingTree(this);
-		newPartner->enqueue();
-		this->size += 2;
-		/* Remove all odd children of the new node, since odd and non-even nodes can't have odd children */
-		while (!child->oddChildren.isEmpty()) {
-			auto elem = child->oddChildren.popElem();
-			elem->value->end->setEvenParent(nullptr);
-		}
-		/* If this gets added, the old blossom should be dead for consistency reasons */
-		if (child->getContainingBlossom() != nullptr) {
-			delete(child->getContainingBlossom());
-		}
-		/* Delete potentially borne blossoms by now odd and non-even node */
-		while (!child->bearingBlossoms.isEmpty()) {
-			delete(child->bearingBlossoms.popElem()->value);
-		}
-		/* Adopt blossoms borne by the matching partner, which is even in this tree */
-		for (auto el = newPartner->bearingBlossoms.getFirstElement(); el != nullptr; el = el->nxtElem) {
-			/* getReference should be redundant here, since we're looking
-			 * at the representant anyways, but just to be sure... */
-			this->adoptBlossom(el->value->getReference());
-		}
-		/* Call recursive, if this MVertex<Label> was hosting an old twig */
-		DEBUG("Node " << newPartner->id << " has " << newPartner->oddChildren.getSize() << " odd children\n");
-		for (auto elem = newPartner->oddChildren.getFirstElement(); elem != nullptr; elem = elem->nxtElem) {
-			HalfEdge<Label>* e = elem->value;
-			MVertex<Label>* child = e->end;
-			DEBUG("Node " << newPartner->id << " considers child " << child->id << "\n");
-			MCherryBlossom<Label> * childBlossom = child->getContainingBlossom();
-			if (childBlossom == nullptr || childBlossom->getReceptacle() != newPartner) {
+		std::vector<AddFrame>& stack = MCherryTree<Label>::addStack;
+		unsigned long base = stack.size();
+		stack.push_back(AddFrame(AddVertex, parentToChild, nullptr));
+		while (stack.size() > base) {
+			/* Invalidated by pushing new frames */
+			AddFrame& frame = stack.back();
+			switch (frame.step) {
+			case AddVertex: {
+#ifdef DEBUG_F
+				MVertex<Label>* parent = frame.edge->start;
+#endif
+				MVertex<Label>* child = frame.edge->end;
+				/* Sanity check */
+				if (child->getContainingTree() != nullptr) {
+					stack.pop_back();
+					break;
+				}
+				TRACE_EVENT(EventGrow, frame.edge->start->id, child->id);
+				/* Update references for containment in tree */
+				MVertex<Label>* newPartner = child->getMatchingPartner();
+				DEBUG("Adding vertices "
+					<< (parent == nullptr ? 0 : parent->id)
+					<< " -> "
+					<< (child == nullptr ? 0 : child->id)
+					<< " -> "
+					<< (newPartner == nullptr ? 0 : newPartner->id) << "\n");
+				child->setEvenParent(frame.edge->inverse);
+				child->setContainingTree(this);
+				newPartner->setContainingTree(this);
+				newPartner->enqueue();
+				this->size += 2;
+				/* Remove all odd children of the new node, since odd and non-even nodes can't have odd children */
+				while (!child->oddChildren.isEmpty()) {
+					auto elem = child->oddChildren.popElem();
+					elem->value->end->setEvenParent(nullptr);
+				}
+				/* If this gets added, the old blossom should be dead for consistency reasons */
+				if (child->getContainingBlossom() != nullptr) {
+					delete(child->getContainingBlossom());
+				}
+				/* Delete potentially borne blossoms by now odd and non-even node */
+				while (!child->bearingBlossoms.isEmpty()) {
+					delete(child->bearingBlossoms.popElem()->value);
+				}
+				frame.blossomEl = newPartner->bearingBlossoms.getFirstElement();
+				frame.step = AddBorneBlossom;
+				break;
+			}
+			case AddBorneBlossom:
+				/* Adopt blossoms borne by the matching partner, which is even in this tree */
+				if (frame.blossomEl != nullptr) {
+					frame.step = AddBorneBlossomDone;
+					/* getReference should be redundant here, since we're looking
+					 * at the representant anyways, but just to be sure... */
+					stack.push_back(AddFrame(AdoptBlossom, nullptr, frame.blossomEl->value->getReference()));
+				} else {
+					MVertex<Label>* newPartner = frame.edge->end->getMatchingPartner();
+					DEBUG("Node " << newPartner->id << " has " << newPartner->oddChildren.getSize() << " odd children\n");
+					frame.edgeEl = newPartner->oddChildren.getFirstElement();
+					frame.step = AddOldChild;
+				}
+				break;
+			case AddBorneBlossomDone:
+				frame.blossomEl = frame.blossomEl->nxtElem;
+				frame.step = AddBorneBlossom;
+				break;
+			case AddOldChild: {
+				/* Continue with the children, if this MVertex<Label> was hosting an old twig */
+				if (frame.edgeEl == nullptr) {
+					frame.step = AddOldParent;
+					break;
+				}
+				MVertex<Label>* newPartner = frame.edge->end->getMatchingPartner();
+				HalfEdge<Label>* e = frame.edgeEl->value;
+				MVertex<Label>* child = e->end;
+				DEBUG("Node " << newPartner->id << " considers child " << child->id << "\n");
+				MCherryBlossom<Label> * childBlossom = child->getContainingBlossom();
 				/* Otherwise this should've been handled by adopting the blossom */
-				if (child->getContainingTree() != this) {
-					this->add(e);
+				if ((childBlossom == nullptr || childBlossom->getReceptacle() != newPartner)
+					&& child->getContainingTree() != this) {
+					frame.step = AddOldChildDone;
+					stack.push_back(AddFrame(AddVertex, e, nullptr));
+				} else {
+					frame.edgeEl = frame.edgeEl->nxtElem;
 				}
+				break;
 			}
-		}
-		/* Safe upwards in the trees */
-		HalfEdge<Label>* pe = newPartner->getEvenParentEdge();
-		if (pe != nullptr) {
-			MVertex<Label>* oldParent = pe->end;
-			newPartner->setEvenParent(nullptr);
-			if (oldParent->getContainingTree() != newPartner->getContainingTree()) {
-				this->add(pe);
+			case AddOldChildDone:
+				frame.edgeEl = frame.edgeEl->nxtElem;
+				frame.step = AddOldChild;
+				break;
+			case AddOldParent: {
+				/* Safe upwards in the trees */
+				MVertex<Label>* newPartner = frame.edge->end->getMatchingPartner();
+				HalfEdge<Label>* pe = newPartner->getEvenParentEdge();
+				/* This is the last step of the frame, so the old parent takes its place */
+				stack.pop_back();
+				if (pe != nullptr) {
+					MVertex<Label>* oldParent = pe->end;
+					newPartner->setEvenParent(nullptr);
+					if (oldParent->getContainingTree() != newPartner->getContainingTree()) {
+						stack.push_back(AddFrame(AddVertex, pe, nullptr));
+					}
+					/* Creating blossoms between two even nodes is dangerous
+					 * while the tree is inconsistent!
+					 * If anyone ever intends to do so, beware of hard bugs to catch. */
+				}
+				break;
+			}
+			case AdoptBlossom:
+				/* The receptacle has just been added and the other vertices of the corolla
+				 * are in no tree yet. Claim the corolla for this tree and manage the children
+				 * of the new nodes. */
+				DEBUG("Adopting blossom " << frame.blossom->getReceptacle()->id << "\n");
+				frame.blossom->updateLevel();
+				frame.vertexEl = frame.blossom->getFirstVertex();
+				frame.step = AdoptVertex;
+				break;
+			case AdoptVertex: {
+				if (frame.vertexEl == nullptr) {
+					stack.pop_back();
+					break;
+				}
+				MVertex<Label>* v = frame.vertexEl->value;
+				DEBUG("Visiting " << v->id << "\n");
+				v->setContainingTree(this);
+				v->enqueue();
+				this->size += 1;
+				frame.blossomEl = v->bearingBlossoms.getFirstElement();
+				frame.step = AdoptBorneBlossom;
+				break;
+			}
+			case AdoptBorneBlossom:
+				/* Adopt further blossoms */
+				if (frame.blossomEl != nullptr) {
+					frame.step = AdoptBorneBlossomDone;
+					stack.push_back(AddFrame(AdoptBlossom, nullptr, frame.blossomEl->value->getReference()));
+				} else {
+					frame.edgeEl = frame.vertexEl->value->oddChildren.getFirstElement();
+					frame.step = AdoptChild;
+				}
+				break;
+			case AdoptBorneBlossomDone:
+				frame.blossomEl = frame.blossomEl->nxtElem;
+				frame.step = AdoptBorneBlossom;
+				break;
+			case AdoptChild:
+				/* Add children to the tree */
+				if (frame.edgeEl == nullptr) {
+					frame.vertexEl = frame.vertexEl->nxtElem;
+					frame.step = AdoptVertex;
+				} else if (frame.edgeEl->value->end->getContainingBlossom() != frame.blossom) {
+					frame.step = AdoptChildDone;
+					stack.push_back(AddFrame(AddVertex, frame.edgeEl->value, nullptr));
+				} else {
+					frame.edgeEl = frame.edgeEl->nxtElem;
+				}
+				break;
+			case AdoptChildDone:
+				frame.edgeEl = frame.edgeEl->nxtElem;
+				frame.step = AdoptChild;
+				break;
 			}
-			/* Creating blossoms between two even nodes is dangerous
-			 * while the tree is inconsistent!
-			 * If anyone ever intends to do so, beware of hard bugs to catch. */
 		}
 		this->consistent = consistencyUpdate;
-		this->printTree();
 	}
 
 	/* Removes a vertex from the tree. Also removes all vertices hanging below
@@ -240,7 +321,15 @@ namespace wr {
 	void MCherryTree<Label>::remove(MVertex<Label> * v) {
 		bool consistencyUpdate = this->consistent;
 		this->consistent = false;
-		if (v->getContainingTree() == this) {
+		std::vector<MVertex<Label>*>& stack = MCherryTree<Label>::vertexStack;
+		unsigned long base = stack.size();
+		stack.push_back(v);
+		while (stack.size() > base) {
+			v = stack.back();
+			stack.pop_back();
+			if (v->getContainingTree() != this) {
+				continue;
+			}
 			v->setContainingTree(nullptr);
 			if (v == this->root) {
 				this->root = nullptr;
@@ -248,10 +337,10 @@ namespace wr {
 			MVertex<Label>* m = v->getMatchingPartner();
 			this->size--;
 			if (m != nullptr) {
-				this->remove(m);
+				stack.push_back(m);
 			}
 			for (auto el = v->oddChildren.getFirstElement(); el != nullptr; el = el->nxtElem) {
-				this->remove(el->value->end);
+				stack.push_back(el->value->end);
 			}
 		}
 		this->consistent = consistencyUpdate;
@@ -297,7 +386,7 @@ namespace wr {
 		uw->deleteStructure();
 		DEBUG("\n");
 #endif
-		this->printTree();
+		TRACE_EVENT(EventBlossom, u->id, w->id);
 		bool consistencyUpdate = this->consistent;
 		this->consistent = false;
 		/* Using the level of the vertices, the search for a common even
@@ -431,7 +520,6 @@ namespace wr {
 			w->setEvenParent(e->inverse);
 		}
 		this->consistent = consistencyUpdate;
-		this->printTree();
 	}
 
 	/* Updates the level of all vertices */
@@ -440,21 +528,21 @@ namespace wr {
 		this->updateLevelBelow(this->root);
 	}
 
-	/* Updates the level of all vertices below the given vertex */
+	/* Updates the level of all vertices below the given vertex in breadth-first order */
 	template <class Label>
 	void MCherryTree<Label>::updateLevelBelow(MVertex<Label> * v) {
-		List<MVertex<Label>>* remainingVertices = new List<MVertex<Label>>();
-		remainingVertices->push(v);
-		while (!remainingVertices->isEmpty()) {
-			MVertex<Label>* w = remainingVertices->pop();
+		std::vector<MVertex<Label>*>& queue = MCherryTree<Label>::vertexStack;
+		unsigned long base = queue.size();
+		queue.push_back(v);
+		for (unsigned long i = base; i < queue.size(); i++) {
+			MVertex<Label>* w = queue[i];
 			w->updateLevel();
 			for (auto childEl = w->oddChildren.getFirstElement(); childEl != nullptr; childEl = childEl->nxtElem) {
 				HalfEdge<Label>* e = childEl->value;
-				MVertex<Label>* m = e->end->getMatchingPartner();
-				remainingVertices->append(m);
+				queue.push_back(e->end->getMatchingPartner());
 			}
 		}
-		remainingVertices->deleteStructure();
+		queue.resize(base);
 	}
 
 	template <class Label>
@@ -480,9 +568,6 @@ namespace wr {
 	}
 
 
-	template <class Label>
-	int MCherryTree<Label>::printCtr = 0;
-
 	template <class Label>
 	void MCherryTree<Label>::logTree() {
 		std::stringstream stream;
@@ -491,62 +576,6 @@ namespace wr {
 		DEBUG(buffer);
 	}
 
-	/* Prints the tree for debugging purposes. This is disabled if not using debugging. */
-	template <class Label>
-	void MCherryTree<Label>::printTree() {
-#ifndef DEBUG_F
-		return;
-#else
-		if (!this->consistent || !DEBUG_ENABLED) {
-			return;
-		}
-		DEBUG("@Tree(" << (this->root == nullptr ? 0 : this->root->id) << ") ");
-		std::stringstream gmlStream, dotStream;
-		gmlStream << "graph [\n";
-		dotStream << "digraph G {\n";
-		auto vs = this->getVertices();
-		for (auto it = vs->getFirstElement(); it != nullptr; it = it->nxtElem) {
-			MVertex<Label>* v = it->value;
-			gmlStream << "\tnode [\n\t\tid " << v->id << "\n\t\tlabel \"" << v->id << "\"\n\t]\n";
-		}
-		for (auto it = vs->getFirstElement(); it != nullptr; it = it->nxtElem) {
-			MVertex<Label>* v = it->value;
-			MVertex<Label>* m = v->getMatchingPartner();
-			MVertex<Label>* p = v->getEvenParent();
-			if (m != nullptr) {
-				gmlStream << "\tedge [\n\t\tsource " << v->id << "\n\t\ttarget " << m->id << "\n\t\tlabel \"m\"\n\t]\n";
-				dotStream << "\t" << v->id << " -> " << m->id << "[color=red,penwidth=2.0];\n";
-			}
-			if (p != nullptr) {
-				gmlStream << "\tedge [\n\t\tsource " << p->id << "\n\t\ttarget " << v->id << "\n\t]\n";
-				dotStream << "\t" << p->id << " -> " << v->id << ";\n";
-			}
-			//for(auto el = v->oddChildren.getFirstElement(); el != nullptr; el = el->nxtElem) {
-				//dotStream << "\t" << v->id << " -> " << el->value->end->id << "[color=blue,penwidth=0.5];\n";
-			//}
-		}
-		gmlStream << "]\n";
-		dotStream << "}\n";
-		std::string gmlBuffer = gmlStream.str(), dotBuffer = dotStream.str();
-		std::ofstream gmlWriter, dotWriter;
-		std::stringstream gmlFileNameBuilder, dotFileNameBuilder;
-		gmlFileNameBuilder << "debug/graphs/" << printCtr << ".gml";
-		dotFileNameBuilder << "debug/graphs/" << printCtr << ".dot";
-		gmlWriter.open(gmlFileNameBuilder.str());
-		dotWriter.open(dotFileNameBuilder.str());
-		if (!gmlWriter.fail() && !dotWriter.fail()) {
-			gmlWriter << gmlBuffer;
-			dotWriter << dotBuffer;
-			DEBUG("Printed image " << printCtr++ << " to files " << gmlFileNameBuilder.str() << " and " << dotFileNameBuilder.str() << "\n");
-		} else {
-			DEBUG("Failed to print image " << printCtr++ << " to files " << gmlFileNameBuilder.str() << " and " << dotFileNameBuilder.str() << "\n");
-		}
-		vs->deleteStructure();
-		gmlWriter.close();
-		dotWriter.close();
-#endif
-}
-
 	template <class Label>
 	void MCherryTree<Label>::recursivePrintNode(MVertex<Label> * v, const std::string & prefix, std::stringstream & stream) {
 		stream << prefix.c_str() << "-> " << v->id;
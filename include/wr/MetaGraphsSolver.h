@@ -20,6 +20,9 @@ namespace wr {
 	private:
 		/* List of all vertices. Basically the graph representation. */
 		std::vector<MVertex<Label>*> vertices;
+		/* Position of every vertex in the order it was added, indexed by its id relative
+		 * to the smallest id. Empty as long as preSort did not renumber the vertices. */
+		std::vector<unsigned int> positions;
 		/* List of remaining search trees. */
 		List<MCherryTree<Label>> remainingTrees;
 		/* GrowQueue containing all vertices, from which growing is possible */
@@ -38,11 +41,14 @@ namespace wr {
 		/* Coefficients for benchmarking */
 		double I;
 		double RI;
+		/* Recursion depth of this solver. The solver for the base graph has depth 0. */
+		unsigned int depth;
 
 		/* Stop growing of cherry trees once a maximum number of meta neighbors is achieved */
 		unsigned int maxMetaNeighbors;
 
 		void preSort();
+		unsigned int getPosition(MVertex<Label>* v, unsigned int firstId);
 		void greedyPreSolve();
 	public:
 		/* Enum to describe which strategy to use for sorting the vertices
@@ -62,6 +68,7 @@ namespace wr {
 		void addMetaEdge(MVertex<Label>* u, MVertex<Label>* v, HalfEdge<Label>* label);
 		std::vector<HalfEdge<Label>*>* getMatching();
 		std::vector<MVertex<Label>*>* getMatchingRepresentatives();
+		void getMatchingMates(unsigned int* mates);
 		std::vector<std::pair<Label, Label>>* getMatchingLabels();
 		void reset();
 
@@ -77,6 +84,7 @@ namespace wr {
 		double getRI();
 
 		void clearVertices();
+		static void prepareScratch();
 	};
 }
 }
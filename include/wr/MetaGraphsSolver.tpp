@@ -17,6 +17,7 @@ namespace wr {
 		, isCalculated(false)
 		, I(0.0)
 		, RI(0.0)
+		, depth(0)
 		, maxMetaNeighbors(maxMetaNeighbors)
 		, preSortStrat(MinDegree) {
 		(void)arg2;
@@ -33,6 +34,12 @@ namespace wr {
 	MetaGraphsSolver<Label>::~MetaGraphsSolver() {}
 
 	/* Clear the vertex list and also delete all contained vertices */
+	/* The trees share their scratch space across solvers */
+	template <class Label>
+	void MetaGraphsSolver<Label>::prepareScratch() {
+		MCherryTree<Label>::resetScratch();
+	}
+
 	template <class Label>
 	void MetaGraphsSolver<Label>::clearVertices() {
 		for (auto it = this->vertices.begin(); it != this->vertices.end(); it++) {
@@ -41,6 +48,7 @@ namespace wr {
 		}
 		this->vertices.clear();
 		this->vertices.shrink_to_fit();
+		this->positions.clear();
 	}
 
 	/* Sorts the vertices according to the defined presort strategy */
@@ -85,6 +93,13 @@ namespace wr {
 				}
 				break;
 		}
+		/* Remember the positions, since the ids are the only link to them */
+		std::vector<unsigned int> sortedPositions(this->vertices.size());
+		for (unsigned int i = 0; i < this->vertices.size(); i++) {
+			unsigned int id = this->vertices[i]->id - minId;
+			sortedPositions[i] = this->positions.empty() ? id : this->positions[id];
+		}
+		this->positions.swap(sortedPositions);
 		for (unsigned int i = 0; i < this->vertices.size(); i++) {
 			MVertex<Label>* v = this->vertices[i];
 			v->id = minId + i;
@@ -201,6 +216,28 @@ namespace wr {
 		return ret;
 	}
 
+	template <class Label>
+	unsigned int MetaGraphsSolver<Label>::getPosition(MVertex<Label>* v, unsigned int firstId) {
+		unsigned int id = v->id - firstId;
+		return this->positions.empty() ? id : this->positions[id];
+	}
+
+	/* The ids of the vertices are consecutive, preSort keeps the positions they were added at */
+	template <class Label>
+	void MetaGraphsSolver<Label>::getMatchingMates(unsigned int* mates) {
+		if (this->vertices.empty()) {
+			return;
+		}
+		unsigned int firstId = this->vertices[0]->id;
+		for (auto v : this->vertices) {
+			firstId = std::min(firstId, v->id);
+		}
+		for (auto v : this->vertices) {
+			auto w = v->getMatchingPartner();
+			mates[this->getPosition(v, firstId)] = w != nullptr ? this->getPosition(w, firstId) : NoMate;
+		}
+	}
+
 	template <class Label>
 	void MetaGraphsSolver<Label>::reset() {
 		while (!remainingTrees.isEmpty()) {
@@ -221,9 +258,13 @@ namespace wr {
 			reset();
 		}
 		DEBUG("\nEntering new meta graph calculation\n");
+		Statistics::startPhase(PhasePreSort);
 		preSort();
+		Statistics::stopPhase(PhasePreSort);
 		/* Start with a fast approximation */
+		Statistics::startPhase(PhaseGreedy);
 		greedyPreSolve();
+		Statistics::stopPhase(PhaseGreedy);
 		DEBUG("Finished greedy approximation\n");
 		/* Initialize problem */
 		MVertex<Label>::resetIds();
@@ -243,12 +284,15 @@ namespace wr {
 			this->I++;
 			this->RI++;
 			/* Grow all trees as long as possible */
+			Statistics::startPhase(PhaseGrow);
 			while (!this->growQueue.isEmpty()) {
 				MVertex<Label>* v = this->growQueue.popElem()->value;
 				this->growFrom(v);
 			}
+			Statistics::stopPhase(PhaseGrow);
 			/* Create a solver for the metagraph and initialize it */
 			MetaGraphsSolver<Label> metaSolver(this->maxMetaNeighbors, 0);
+			metaSolver.depth = this->depth + 1;
 			for (auto el = this->remainingTrees.getFirstElement(); el != nullptr; el = el->nxtElem) {
 				MVertex<Label>* mv = el->value->metaVertex;
 				/* Only use metavertices with neighbors */
@@ -266,11 +310,15 @@ namespace wr {
 			if (metaSolver.vertices.size() == 0) {
 				keepRunning = false;
 			} else {
+				Statistics::startPhase(Statistics::getMetaSolvePhase(metaSolver.depth));
 				metaSolver.calculateMaxMatching();
+				Statistics::stopPhase(Statistics::getMetaSolvePhase(metaSolver.depth));
 				this->I += metaSolver.getI() * .5;
 				this->RI += metaSolver.getRI() * metaSolver.getVertices().size() / this->getVertices().size();
 				auto matching = metaSolver.getMatchingRepresentatives();
+				Statistics::startPhase(PhaseApply);
 				this->applyMetaMatching(matching);
+				Statistics::stopPhase(PhaseApply);
 				delete(matching);
 				/* Exit if there is 0 or 1 unmatched vertices */
 				if (this->remainingTrees.getSize() <= 1) {
@@ -323,7 +371,9 @@ namespace wr {
 			if (w->isEven()) {
 				if (tw == tv) {
 					/* In the same tree -> check for blossom creation */
+					Statistics::startPhase(PhaseShrink);
 					tw->makeBlossom(e);
+					Statistics::stopPhase(PhaseShrink);
 				} else {
 					/* In another tree -> create metaedge */
 					this->addMetaEdge(tv->metaVertex, tw->metaVertex, e);
@@ -352,6 +402,7 @@ namespace wr {
 			tw->rotate(w);
 			v->setMatchingPartner(vw);
 			w->setMatchingPartner(vw->inverse);
+			TRACE_EVENT(EventAugment, v->id, w->id);
 			this->remainingTrees.remove(&tv->listElem);
 			this->remainingTrees.remove(&tw->listElem);
 			twinTrees.append(tv);
@@ -372,8 +423,8 @@ namespace wr {
 		List<MVertex<Label>> vs;
 		while (!twinTrees->isEmpty()) {
 			MCherryTree<Label>* tree = twinTrees->pop();
-			tree->printTree();
 			auto lvs = tree->getVertices();
+			TRACE_EVENT(EventDissolve, tree->root->id, lvs->getSize());
 			/* Remove references to the old tree */
 			while (!lvs->isEmpty()) {
 				MVertex<Label>* s = lvs->pop();
@@ -401,7 +452,6 @@ namespace wr {
 					DEBUG("Adapting " << s->id << " into tree " << newTree->root->id << "\n");
 					newTree->add(st->inverse);
 					newTree->updateLevelBelow(s->getMatchingPartner());
-					newTree->printTree();
 					break;
 				}
 			}
@@ -0,0 +1,7 @@
+#include "Debug.h"
+
+#ifdef DEBUG_F
+bool DEBUG_ENABLED = true;
+#else
+bool DEBUG_ENABLED = false;
+#endif
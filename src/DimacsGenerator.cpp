@@ -1,145 +1,143 @@
 #include "DimacsGenerator.h"
+#include <cmath>
+#include <random>
+#include "GGenerator.h"
 
 namespace maxmatching {
+	DimacsGenerator::DimacsGenerator() {}
 
 	DimacsGenerator::~DimacsGenerator() {}
 
-	/* Has to generate a random int in [1..max] */
-	unsigned long DimacsGenerator::rand_long(unsigned long max, std::mt19937_64& rgen) {
-		return (unsigned long)(rand_d(rgen) * (max - 1)) + 1;
-	}
-	/* Has to generate a random double in [0..1] */
-	double DimacsGenerator::rand_d(std::mt19937_64& rgen) {
-		return rgen() / ((double)rgen.max());
-	}
-
-	void DimacsGenerator::insert(unsigned long arc) {
-		treenode* current = NULL;
-		treenode* parent = NULL;
-		if (arc_size == 0) {  /* first insertion */
-			root = (treenode*)malloc(1 * sizeof(treenode));
-			root->val = arc;
-			root->left = NULL;
-			root->right = NULL;
-		} else {
-			current = root;
-			while (current != NULL) {
-				parent = current;
-				/* search for the empty spot, saving parent */
-				if (arc < parent->val) {
-					current = parent->left;
-				} else if (arc > parent->val) {
-					current = parent->right;
-				}
-			}/* while */
-			current = (treenode*)malloc(1 * sizeof(treenode));
-			current->val = arc;
-			current->left = NULL;
-			current->right = NULL;
-			if (arc < (parent->val)) {
-				parent->left = current;
-			} else {
-				parent->right = current;
+	/* Number of successes when drawing without replacement. The probabilities are
+	 * computed relative to the mode with the ratios of consecutive terms and summed
+	 * until they vanish, which avoids the cancellation of log factorials
+	 * for populations of about n^2 / 2 pairs. */
+	unsigned long DimacsGenerator::sampleHypergeometric(unsigned long population, unsigned long successes, unsigned long draws, RandomStream& rgen) {
+		if (draws == 0 || successes == 0) {
+			return 0;
+		} else if (successes == population) {
+			return draws;
+		} else if (draws == population) {
+			return successes;
+		}
+		double N = population, K = successes, n = draws;
+		unsigned long lo = draws > population - successes ? draws - (population - successes) : 0;
+		unsigned long hi = std::min(draws, successes);
+		unsigned long mode = (unsigned long)((n + 1) * (K + 1) / (N + 2));
+		mode = std::max(lo, std::min(hi, mode));
+		/* Weights of mode + 1, mode + 2, ... and of mode - 1, mode - 2, ... */
+		std::vector<double> up, down;
+		double sum = 1.0;
+		double w = 1.0;
+		for (unsigned long k = mode; k < hi; k++) {
+			w *= (K - k) * (n - k) / ((k + 1) * (N - K - n + k + 1));
+			if (w < 1e-18 * sum) {
+				break;
 			}
-		}/*else not new  */
-		arc_size++;
-	}
-
-	bool DimacsGenerator::inset(unsigned long arc) {
-		treenode* current;
-		current = root;
-		while (current != NULL) {
-			if (current->val > arc) {
-				current = current->left;
-			} else if (current->val < arc) {
-				current = current->right;
-			} else {
-				return true;
+			up.push_back(w);
+			sum += w;
+		}
+		w = 1.0;
+		for (unsigned long k = mode; k > lo; k--) {
+			w *= k * (N - K - n + k) / ((K - k + 1) * (n - k + 1));
+			if (w < 1e-18 * sum) {
+				break;
+			}
+			down.push_back(w);
+			sum += w;
+		}
+		double u = std::uniform_real_distribution<double>(0.0, sum)(rgen);
+		if (u < 1.0) {
+			return mode;
+		}
+		u -= 1.0;
+		for (unsigned long i = 0; i < up.size(); i++) {
+			if (u < up[i]) {
+				return mode + i + 1;
 			}
-		}/*while*/
-		return false;
+			u -= up[i];
+		}
+		for (unsigned long i = 0; i < down.size(); i++) {
+			if (u < down[i]) {
+				return mode - i - 1;
+			}
+			u -= down[i];
+		}
+		return mode;
 	}
 
-	void DimacsGenerator::generateEdgesSparse(SimpleGraph<unsigned int> * graph, unsigned long nEdges, std::mt19937_64 & rgen) {
-		unsigned long src, dst, a;
-		//unsigned int cost;
-		unsigned long nNodes = graph->getVertexCount();
-		unsigned long maxArcs = ((nNodes * nNodes) - nNodes);
-		for (unsigned long i = 0; i < nEdges; i++) {
-			/* loop until an unused edge is found */
-			/* and dont allow the upper diagonal */
-			do {
-				a = rand_long(maxArcs, rgen);
-				src = ((a - 1) / (nNodes - 1)) + 1;		/* row number in 1..n */
-				dst = (a % (nNodes - 1)) + 1;			/* col number in 1..n-1 */
-				if (src == dst) {						/* move arc [i,i] to [i,n] */
-					dst = nNodes;
+	/* Draws k distinct numbers from [0, size) in ascending order. Dense samples use
+	 * selection sampling (Knuth's algorithm S), sparse ones draw with replacement,
+	 * then sort, remove duplicates and draw the missing numbers again. */
+	void DimacsGenerator::sampleSorted(unsigned long size, unsigned long k, RandomStream& rgen, std::vector<unsigned long>& ret) {
+		ret.clear();
+		ret.reserve(k);
+		if (k > size / 4) {
+			for (unsigned long i = 0; i < size && ret.size() < k; i++) {
+				if (std::uniform_int_distribution<unsigned long>(0, size - i - 1)(rgen) < k - ret.size()) {
+					ret.push_back(i);
 				}
-			} while ((src > dst) || inset(a));
-			/* found one */
-			insert(a);
-			//cost = rand_long(MAXCOST, rgen);
-			graph->addEdgeSym(src - 1, dst - 1);
+			}
+			return;
+		}
+		std::uniform_int_distribution<unsigned long> dist(0, size - 1);
+		while (ret.size() < k) {
+			for (unsigned long missing = k - ret.size(); missing > 0; missing--) {
+				ret.push_back(dist(rgen));
+			}
+			std::sort(ret.begin(), ret.end());
+			ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
 		}
 	}
 
-	void DimacsGenerator::generateEdgesDense(SimpleGraph<unsigned int> * graph, unsigned long nEdges, std::mt19937_64 & rgen) {
-		unsigned int nNodes = graph->getVertexCount();
-		unsigned long maxArcs = ((nNodes * nNodes) - nNodes);
-		unsigned long maxEdges = maxArcs / 2;
-		//unsigned int cost;
-		double need = (double)nEdges;
-		double total = (double)maxEdges;
-		double have = 0.0;    /* increment each time one is printed */
-		double seen = 0.0;    /* increment each time one is examined */
-		/* consider each edge in turn and decide whether to use it */
-		for (unsigned long src = 1; src <= nNodes; src++) {
-			for (unsigned long dst = 1; dst < src; dst++) {
-				if (have >= need) {
-					break;
-				}
-				double x = rand_d(rgen);
-				/* choose current edge with prob =  */
-				/* (number left to choose)/(number left in set) */
-				if ((total - seen) * x < (need - have)) {
-					//cost = rand_long(MAXCOST, rgen);
-					graph->addEdge(src - 1, dst - 1);
-					have++;
-				}
-				seen++;
+	/* Samples the edges of a block and calls func for each (u,v), u > v */
+	void DimacsGenerator::forEachEdge(const Block& block, RandomStream rgen, const std::function<void(unsigned int, unsigned int)>& func) {
+		unsigned long nPairs = (block.endRow * (block.endRow - 1) - block.firstRow * (block.firstRow - 1)) / 2;
+		std::vector<unsigned long> pairs;
+		DimacsGenerator::sampleSorted(nPairs, block.nEdges, rgen, pairs);
+		/* Row u holds u pairs, starting at rowStart within the block */
+		unsigned long u = block.firstRow, rowStart = 0;
+		for (unsigned long pair : pairs) {
+			while (pair >= rowStart + u) {
+				rowStart += u;
+				u++;
 			}
+			func(u, pair - rowStart);
 		}
 	}
 
-	SimpleGraph<unsigned int>* DimacsGenerator::generate(unsigned long nPoints, unsigned long nEdges, std::mt19937_64 & rgen) {
+	SimpleGraph<unsigned int>* DimacsGenerator::generate(unsigned long nPoints, unsigned long nEdges, unsigned long seed) {
 		SimpleGraph<unsigned int>* ret = new SimpleGraph<unsigned int>();
 		for (unsigned long i = 0; i < nPoints; i++) {
 			ret->addVertex(i);
 		}
-		/*  use different generation routines depending on density */
-		unsigned long maxArcs = ((nPoints * nPoints) - nPoints);
-		if (nEdges < maxArcs / 8) {
-			generateEdgesSparse(ret, nEdges, rgen);
-		} else {
-			generateEdgesDense(ret, nEdges, rgen);
+		unsigned long maxEdges = nPoints < 2 ? 0 : nPoints * (nPoints - 1) / 2;
+		nEdges = std::min(nEdges, maxEdges);
+		if (nEdges == 0) {
+			return ret;
 		}
-		/* Clean up */
-		std::vector<treenode*> treeNodes;
-		treeNodes.push_back(root);
-		for (unsigned long i = 0; i < treeNodes.size(); i++) {
-			treenode* n = treeNodes[i];
-			if (n->left != NULL) {
-				treeNodes.push_back(n->left);
+		/* Split the rows into blocks and distribute the edges among them */
+		RandomStream rgen(seed, 0);
+		unsigned long blockPairs = (unsigned long)std::ceil((double)maxEdges / nEdges * DimacsGenerator::EDGES_PER_BLOCK);
+		std::vector<Block> blocks;
+		unsigned long remainingPairs = maxEdges, remainingEdges = nEdges;
+		for (unsigned long row = 1; row < nPoints;) {
+			Block block;
+			block.firstRow = row;
+			unsigned long pairs = 0;
+			while (row < nPoints && (pairs == 0 || pairs + row <= blockPairs)) {
+				pairs += row;
+				row++;
 			}
-			if (n->right != NULL) {
-				treeNodes.push_back(n->right);
-			}
-		}
-		for (treenode* n : treeNodes) {
-			free(n);
+			block.endRow = row;
+			block.nEdges = DimacsGenerator::sampleHypergeometric(remainingPairs, pairs, remainingEdges, rgen);
+			remainingPairs -= pairs;
+			remainingEdges -= block.nEdges;
+			blocks.push_back(block);
 		}
-		arc_size = 0;
-		root = NULL;
+		GGenerator::addEdgeBlocks(ret, blocks.size(), [&blocks, seed](unsigned long b, const GGenerator::EdgeCallback& addEdge) {
+			DimacsGenerator::forEachEdge(blocks[b], RandomStream(seed, b + 1), addEdge);
+		}, false);
 		return ret;
 	}
 }
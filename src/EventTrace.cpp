@@ -0,0 +1,131 @@
+#include "EventTrace.h"
+#include <csignal>
+#include <cstring>
+#include <unistd.h>
+
+namespace maxmatching {
+	unsigned int EventTrace::enabledMask = 0;
+	/* Until a capacity is set, all events overwrite one slot */
+	static Event defaultBuffer[1];
+	Event* EventTrace::buffer = defaultBuffer;
+	unsigned long EventTrace::capacity = 1;
+	unsigned long EventTrace::nEvents = 0;
+
+	EventTrace::EventTrace() {}
+	EventTrace::~EventTrace() {}
+
+	void EventTrace::setCapacity(unsigned long capacity) {
+		unsigned long rounded = 1;
+		while (rounded < capacity && rounded < EventTrace::MAX_CAPACITY) {
+			rounded <<= 1;
+		}
+		if (EventTrace::buffer != defaultBuffer) {
+			delete[](EventTrace::buffer);
+		}
+		EventTrace::buffer = new Event[rounded]();
+		EventTrace::capacity = rounded;
+		EventTrace::nEvents = 0;
+	}
+
+	void EventTrace::setEnabled(EventType type, bool enabled) {
+		if (enabled) {
+			EventTrace::enabledMask |= 1u << type;
+		} else {
+			EventTrace::enabledMask &= ~(1u << type);
+		}
+	}
+
+	bool EventTrace::setEnabled(const std::string& categories) {
+		std::string::size_type start = 0;
+		while (start <= categories.size()) {
+			std::string::size_type end = categories.find(',', start);
+			if (end == std::string::npos) {
+				end = categories.size();
+			}
+			std::string name = categories.substr(start, end - start);
+			bool found = false;
+			for (unsigned int type = 0; type < EventTypeCount; type++) {
+				if (name == "all" || name == EventTrace::getTypeName((EventType)type)) {
+					EventTrace::setEnabled((EventType)type, true);
+					found = true;
+				}
+			}
+			if (!found) {
+				return false;
+			}
+			start = end + 1;
+		}
+		return true;
+	}
+
+	std::string EventTrace::getTypeName(EventType type) {
+		switch (type) {
+			case EventGrow: return "grow";
+			case EventBlossom: return "blossom";
+			case EventRotate: return "rotate";
+			case EventAugment: return "augment";
+			case EventDissolve: return "dissolve";
+			default: return "unknown";
+		}
+	}
+
+	void EventTrace::dump(std::ostream& stream) {
+		unsigned long first = EventTrace::nEvents > EventTrace::capacity ? EventTrace::nEvents - EventTrace::capacity : 0;
+		stream << "Last " << EventTrace::nEvents - first << " of " << EventTrace::nEvents << " traced events:\n";
+		for (unsigned long i = first; i < EventTrace::nEvents; i++) {
+			Event& ev = EventTrace::buffer[i & (EventTrace::capacity - 1)];
+			stream << ev.seq << " " << EventTrace::getTypeName(ev.type) << " " << ev.a << " " << ev.b << "\n";
+		}
+		stream.flush();
+	}
+
+	/* Writes an unsigned number into the buffer, returns the number of characters */
+	static unsigned int formatNumber(char* out, unsigned long value) {
+		char digits[24];
+		unsigned int n = 0;
+		do {
+			digits[n++] = '0' + value % 10;
+			value /= 10;
+		} while (value > 0);
+		for (unsigned int i = 0; i < n; i++) {
+			out[i] = digits[n - 1 - i];
+		}
+		return n;
+	}
+
+	/* Only uses async signal safe functions, so no streams and no allocations */
+	void EventTrace::crashHandler(int signal) {
+		static const char* names[EventTypeCount] = { "grow", "blossom", "rotate", "augment", "dissolve" };
+		const char header[] = "Crashed, last traced events:\n";
+		ssize_t ignored = write(STDERR_FILENO, header, sizeof(header) - 1);
+		unsigned long first = EventTrace::nEvents > EventTrace::capacity ? EventTrace::nEvents - EventTrace::capacity : 0;
+		for (unsigned long i = first; i < EventTrace::nEvents; i++) {
+			Event& ev = EventTrace::buffer[i & (EventTrace::capacity - 1)];
+			char line[128];
+			unsigned int len = formatNumber(line, ev.seq);
+			line[len++] = ' ';
+			const char* name = ev.type < EventTypeCount ? names[ev.type] : "unknown";
+			std::size_t nameLen = std::strlen(name);
+			std::memcpy(line + len, name, nameLen);
+			len += nameLen;
+			line[len++] = ' ';
+			len += formatNumber(line + len, ev.a);
+			line[len++] = ' ';
+			len += formatNumber(line + len, ev.b);
+			line[len++] = '\n';
+			ignored = write(STDERR_FILENO, line, len);
+		}
+		(void)ignored;
+		/* Continue with the default behaviour, e.g. a core dump */
+		std::signal(signal, SIG_DFL);
+		std::raise(signal);
+	}
+
+	void EventTrace::installCrashHandler() {
+		std::signal(SIGSEGV, EventTrace::crashHandler);
+		std::signal(SIGBUS, EventTrace::crashHandler);
+		std::signal(SIGFPE, EventTrace::crashHandler);
+		std::signal(SIGILL, EventTrace::crashHandler);
+		std::signal(SIGABRT, EventTrace::crashHandler);
+	}
+}
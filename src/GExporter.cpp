@@ -1,25 +1,100 @@
 #include "GExporter.h"
+#ifdef HAS_ZSTD
+#include "boost/iostreams/filter/zstd.hpp"
+#include "boost/iostreams/filtering_stream.hpp"
+#include "boost/iostreams/device/back_inserter.hpp"
+#endif
 
 
 namespace maxmatching {
+	const char GExporter::MAGIC[4] = { 'M', 'G', 'R', 'C' };
+#ifdef HAS_ZSTD
+	const unsigned int GExporter::CODEC = 1;
+#else
+	const unsigned int GExporter::CODEC = 0;
+#endif
+
 	GExporter::GExporter() {}
 
 
 	GExporter::~GExporter() {}
 
+	/* Seven bits per byte, the highest bit marks that more bytes follow */
+	void GExporter::writeVarint(unsigned long value, std::string& out) {
+		while (value >= 0x80) {
+			out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<char>(value));
+	}
+
+	void GExporter::encodeBlock(const std::vector<std::vector<unsigned int>*>& rows, unsigned long first, unsigned long end, std::string& out) {
+		std::vector<unsigned int> sorted;
+		for (unsigned long v = first; v < end; v++) {
+			const std::vector<unsigned int>* row = rows[v];
+			if (!std::is_sorted(row->begin(), row->end())) {
+				sorted.assign(row->begin(), row->end());
+				std::sort(sorted.begin(), sorted.end());
+				row = &sorted;
+			}
+			GExporter::writeVarint(row->size(), out);
+			if (row->empty()) {
+				continue;
+			}
+			long delta = (long)(*row)[0] - (long)v;
+			GExporter::writeVarint(((unsigned long)delta << 1) ^ (unsigned long)(delta >> 63), out);
+			for (unsigned long i = 1; i < row->size(); i++) {
+				GExporter::writeVarint((*row)[i] - (*row)[i - 1], out);
+			}
+		}
+	}
+
 	void GExporter::writeFile(std::string file, SimpleGraph<unsigned int>* g) {
 		Files::makePathToFile(file);
-		auto out = std::ofstream(file);
-		out << g->getVertexCount() << "\n";
-		std::map<unsigned int, unsigned int> inverseMap;
-		for (auto v : g->indexMap) {
-			inverseMap[v.second] = v.first;
+		unsigned long nVertices = g->getVertexCount();
+		std::vector<std::vector<unsigned int>*> rows;
+		rows.reserve(nVertices);
+		for (auto& pair : g->adjacencies) {
+			rows.push_back(pair.second);
 		}
-		for (auto v : g->indexMap) {
-			for (auto e : *(g->adjacencies[v.second])) {
-				out << v.first << " " << inverseMap[e] << "\n";
-			}
+		const unsigned long perBlock = GExporter::VERTICES_PER_BLOCK;
+		unsigned long nBlocks = (nVertices + perBlock - 1) / perBlock;
+		std::vector<std::string> blocks(nBlocks);
+		Parallel::forEach(nBlocks, [&rows, &blocks, nVertices, perBlock](unsigned long b) {
+			std::string raw;
+			GExporter::encodeBlock(rows, b * perBlock, std::min(nVertices, (b + 1) * perBlock), raw);
+#ifdef HAS_ZSTD
+			boost::iostreams::filtering_ostream compressor;
+			compressor.push(boost::iostreams::zstd_compressor(boost::iostreams::zstd_params(3)));
+			compressor.push(boost::iostreams::back_inserter(blocks[b]));
+			compressor.write(raw.data(), raw.size());
+			compressor.reset();
+#else
+			blocks[b].swap(raw);
+#endif
+		});
+		std::ofstream out(file, std::ios::binary);
+		auto writeInt = [&out](unsigned int value) {
+			out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+		};
+		auto writeLong = [&out](unsigned long value) {
+			out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+		};
+		out.write(GExporter::MAGIC, sizeof(GExporter::MAGIC));
+		writeInt(GExporter::VERSION);
+		writeInt(GExporter::CODEC);
+		writeInt(GExporter::VERTICES_PER_BLOCK);
+		writeLong(nVertices);
+		writeLong(nBlocks);
+		unsigned long offset = 0;
+		writeLong(offset);
+		for (auto& block : blocks) {
+			offset += block.size();
+			writeLong(offset);
+		}
+		for (auto& block : blocks) {
+			out.write(block.data(), block.size());
 		}
 		out.close();
 	}
-}
\ No newline at end of file
+}
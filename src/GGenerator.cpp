@@ -1,47 +1,97 @@
 #include "GGenerator.h"
+#include <atomic>
+#include <stdexcept>
 
 
 namespace maxmatching {
 	GGenerator::GGenerator() {}
 	GGenerator::~GGenerator() {}
 
-	SimpleGraph<unsigned int>* GGenerator::createRandomBoost(unsigned int nVertices, unsigned int nNeighbors, std::mt19937_64 &rgen) {
+	void GGenerator::sortAdjacencies(std::vector<std::vector<unsigned int>*>& rows, bool removeParallel) {
+		const unsigned long rowsPerTask = 4096;
+		unsigned long nRows = rows.size();
+		Parallel::forEach((nRows + rowsPerTask - 1) / rowsPerTask, [&rows, nRows, rowsPerTask, removeParallel](unsigned long t) {
+			for (unsigned long i = t * rowsPerTask; i < std::min(nRows, (t + 1) * rowsPerTask); i++) {
+				std::sort(rows[i]->begin(), rows[i]->end());
+				if (removeParallel) {
+					rows[i]->erase(std::unique(rows[i]->begin(), rows[i]->end()), rows[i]->end());
+				}
+			}
+		});
+	}
+
+	void GGenerator::addEdgeBlocks(SimpleGraph<unsigned int>* graph, unsigned long nBlocks, const EdgeBlock& block, bool removeParallel) {
+		unsigned int n = graph->getVertexCount();
+		std::vector<std::vector<unsigned int>*> rows;
+		rows.reserve(n);
+		for (auto& pair : graph->adjacencies) {
+			rows.push_back(pair.second);
+		}
+		std::vector<std::atomic<unsigned int>> degrees(n);
+		Parallel::forEach(nBlocks, [&block, &degrees](unsigned long b) {
+			block(b, [&degrees](unsigned int u, unsigned int v) {
+				degrees[u].fetch_add(1, std::memory_order_relaxed);
+				degrees[v].fetch_add(1, std::memory_order_relaxed);
+			});
+		});
+		/* Next free entry of every list. Keeping the pointers in one array saves
+		 * a cache miss on the list itself for every written edge. */
+		std::vector<std::atomic<unsigned int*>> cursors(n);
+		for (unsigned int i = 0; i < n; i++) {
+			unsigned int size = rows[i]->size();
+			rows[i]->resize(size + degrees[i].load());
+			cursors[i].store(rows[i]->data() + size);
+		}
+		Parallel::forEach(nBlocks, [&block, &cursors](unsigned long b) {
+			block(b, [&cursors](unsigned int u, unsigned int v) {
+				*cursors[u].fetch_add(1, std::memory_order_relaxed) = v;
+				*cursors[v].fetch_add(1, std::memory_order_relaxed) = u;
+			});
+		});
+		GGenerator::sortAdjacencies(rows, removeParallel);
+	}
+
+	/* Draws <nNeighbors> * <nVertices> random pairs of distinct vertices like
+	 * boost::generate_random_graph on a boost::undirected_graph and removes parallel edges.
+	 * The pairs are drawn in blocks, each from its own random stream. */
+	SimpleGraph<unsigned int>* GGenerator::createRandomBoost(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed) {
 		auto ret = new SimpleGraph<unsigned int>();
-		typedef boost::undirected_graph<> Graph;
-		typedef boost::property_map<Graph, boost::vertex_index_t>::type IndexMap;
-		//typedef boost::graph_traits < Graph >::adjacency_iterator AdjIterator;
-		Graph boostGraph;
-		boost::generate_random_graph(boostGraph, nVertices, nVertices * nNeighbors, rgen);
-		IndexMap index = boost::get(boost::vertex_index, boostGraph);
-		auto vertices = boost::vertices(boostGraph);
-		for (; vertices.first != vertices.second; vertices.first++) {
-			ret->addVertex(index[*vertices.first]);
-		}
-		auto edges = boost::edges(boostGraph);
-		for (; edges.first != edges.second; edges.first++) {
-			auto e = *edges.first;
-			ret->addEdgeSym(index[e.m_source], index[e.m_target]);
-		}
-		ret->cleanUp();
+		for (unsigned int i = 0; i < nVertices; i++) {
+			ret->addVertex(i);
+		}
+		if (nVertices < 2) {
+			return ret;
+		}
+		const unsigned long pairsPerBlock = 1 << 20;
+		unsigned long nEdges = (unsigned long)nVertices * nNeighbors;
+		GGenerator::addEdgeBlocks(ret, (nEdges + pairsPerBlock - 1) / pairsPerBlock, [nVertices, nEdges, seed, pairsPerBlock](unsigned long b, const EdgeCallback& addEdge) {
+			RandomStream rgen(seed, b);
+			std::uniform_int_distribution<unsigned int> draw(0, nVertices - 1);
+			for (unsigned long j = b * pairsPerBlock; j < std::min(nEdges, (b + 1) * pairsPerBlock); j++) {
+				unsigned int u = draw(rgen), v;
+				do {
+					v = draw(rgen);
+				} while (u == v);
+				addEdge(u, v);
+			}
+		}, true);
 		return ret;
 	}
 
-	SimpleGraph<unsigned int>* GGenerator::createRandomDimacs(unsigned int nVertices, unsigned int nNeighbors, std::mt19937_64 &rgen) {
+	SimpleGraph<unsigned int>* GGenerator::createRandomDimacs(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed) {
 		DimacsGenerator dg;
-		return dg.generate(nVertices, nVertices * nNeighbors, rgen);
+		return dg.generate(nVertices, (unsigned long)nVertices * nNeighbors, seed);
 	}
 
-#ifdef HAS_FADE
-	SimpleGraph<unsigned int>* GGenerator::createRandomTriangle(unsigned int nVertices, std::mt19937_64 &rgen) {
+	SimpleGraph<unsigned int>* GGenerator::createRandomTriangle(unsigned int nVertices, unsigned long seed) {
 		TriangleGenerator tg;
-		return tg.generate(nVertices, rgen);
+		return tg.generate(nVertices, seed);
 	}
-#endif
 
 #define MAKE_RANDOM_EUCLID(DIM) \
-/**/SimpleGraph<unsigned int>* GGenerator::createRandomEuclid ## DIM ## d(unsigned int nVertices, unsigned int nNeighbors, std::mt19937_64 &rgen) { \
+/**/SimpleGraph<unsigned int>* GGenerator::createRandomEuclid ## DIM ## d(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed) { \
 /**/	typedef std::array<double, DIM> tuple; \
-/**/	return this->createRandomEuclid<tuple>(nVertices, nNeighbors, rgen); \
+/**/	return this->createRandomEuclid<tuple>(nVertices, nNeighbors, seed); \
 /**/}
 	MAKE_RANDOM_EUCLID(2);
 	MAKE_RANDOM_EUCLID(3);
@@ -49,6 +99,196 @@ namespace maxmatching {
 	MAKE_RANDOM_EUCLID(20);
 #undef MAKE_RANDOM_EUCLID
 
+	unsigned long GGenerator::toThreshold(double p) {
+		if (p <= 0) {
+			return 0;
+		}
+		if (p >= 1) {
+			return ~0ul;
+		}
+		return (unsigned long)(p * 18446744073709551616.0);
+	}
+
+	/* Draws <nNeighbors> * <nVertices> edges with the recursive matrix model of Chakrabarti et al.,
+	 * "R-MAT: A Recursive Model for Graph Mining". On every level, an edge descends into one
+	 * quadrant of the adjacency matrix with the probabilities a, b, c and 1 - a - b - c, which
+	 * results in a skewed degree distribution. Edges ending outside of the graph, if the number
+	 * of vertices is no power of two, and loops are drawn again, parallel edges are removed.
+	 * b + c has to be positive, otherwise only loops can be drawn. */
+	SimpleGraph<unsigned int>* GGenerator::createRandomRMat(unsigned int nVertices, unsigned int nNeighbors, double a, double b, double c, unsigned long seed) {
+		auto ret = new SimpleGraph<unsigned int>();
+		for (unsigned int i = 0; i < nVertices; i++) {
+			ret->addVertex(i);
+		}
+		if (nVertices < 2) {
+			return ret;
+		}
+		unsigned int scale = 0;
+		while ((1ul << scale) < nVertices) {
+			scale++;
+		}
+		/* Every random number is used for two levels with 32 bits each */
+		unsigned int ta = GGenerator::toThreshold(a) >> 32;
+		unsigned int tab = GGenerator::toThreshold(a + b) >> 32;
+		unsigned int tabc = GGenerator::toThreshold(a + b + c) >> 32;
+		const unsigned long edgesPerBlock = 1 << 20;
+		unsigned long nEdges = (unsigned long)nVertices * nNeighbors;
+		GGenerator::addEdgeBlocks(ret, (nEdges + edgesPerBlock - 1) / edgesPerBlock, [=](unsigned long block, const EdgeCallback& addEdge) {
+			RandomStream rgen(seed, block);
+			for (unsigned long j = block * edgesPerBlock; j < std::min(nEdges, (block + 1) * edgesPerBlock); j++) {
+				unsigned long u, v;
+				do {
+					u = 0;
+					v = 0;
+					unsigned long bits = 0;
+					for (unsigned int l = 0; l < scale; l++) {
+						bits = l % 2 == 0 ? rgen() : bits >> 32;
+						unsigned int r = bits;
+						u <<= 1;
+						v <<= 1;
+						if (r >= tabc) {
+							u |= 1;
+							v |= 1;
+						} else if (r >= tab) {
+							u |= 1;
+						} else if (r >= ta) {
+							v |= 1;
+						}
+					}
+				} while (u >= nVertices || v >= nVertices || u == v);
+				addEdge(u, v);
+			}
+		}, true);
+		return ret;
+	}
+
+	/* Preferential attachment in the model of Barabasi and Albert, "Emergence of Scaling in
+	 * Random Networks": every vertex connects to <nNeighbors> earlier vertices, chosen with
+	 * a probability proportional to their degree. The edges are generated independently like
+	 * by Sanders and Schulz, "Scalable Generation of Scale-free Graphs": edge i has its source
+	 * i / nNeighbors at position 2i and its target at position 2i + 1 of a virtual edge list.
+	 * A target copies a uniformly random earlier position, which is resolved by following the
+	 * choices of the positions, each drawn from its own stream, until a source is reached.
+	 * Loops and parallel edges are removed. */
+	SimpleGraph<unsigned int>* GGenerator::createRandomBarabasiAlbert(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed) {
+		auto ret = new SimpleGraph<unsigned int>();
+		for (unsigned int i = 0; i < nVertices; i++) {
+			ret->addVertex(i);
+		}
+		if (nVertices < 2 || nNeighbors == 0) {
+			return ret;
+		}
+		const unsigned long edgesPerBlock = 1 << 20;
+		unsigned long nEdges = (unsigned long)nVertices * nNeighbors;
+		GGenerator::addEdgeBlocks(ret, (nEdges + edgesPerBlock - 1) / edgesPerBlock, [nEdges, nNeighbors, seed, edgesPerBlock](unsigned long block, const EdgeCallback& addEdge) {
+			for (unsigned long j = block * edgesPerBlock; j < std::min(nEdges, (block + 1) * edgesPerBlock); j++) {
+				unsigned long position = 2 * j + 1;
+				while (position % 2 == 1) {
+					RandomStream rgen(seed, position);
+					position = std::uniform_int_distribution<unsigned long>(0, position - 1)(rgen);
+				}
+				unsigned int u = j / nNeighbors;
+				unsigned int v = position / 2 / nNeighbors;
+				if (u != v) {
+					addEdge(u, v);
+				}
+			}
+		}, true);
+		return ret;
+	}
+
+	/* Random <nNeighbors>-regular graph as union of nNeighbors / 2 random hamiltonian cycles
+	 * and, for an odd degree, a random perfect matching. This distribution is contiguous to the
+	 * uniform one (Kim and Wormald, "Random Matchings which Induce Hamilton Cycles, and
+	 * Hamiltonian Decompositions of Random Regular Graphs"). Every cycle and the matching draw
+	 * their vertex order from their own stream and are generated by parallel tasks. The rare
+	 * parallel edges are removed, which leaves their ends with a smaller degree, just like the
+	 * last vertex of the matching, if the number of vertices is odd. */
+	SimpleGraph<unsigned int>* GGenerator::createRandomRegular(unsigned int nVertices, unsigned int nNeighbors, unsigned long seed) {
+		auto ret = new SimpleGraph<unsigned int>();
+		for (unsigned int i = 0; i < nVertices; i++) {
+			ret->addVertex(i);
+		}
+		nNeighbors = std::min(nNeighbors, nVertices - 1);
+		if (nVertices < 2 || nNeighbors == 0) {
+			return ret;
+		}
+		unsigned int nCycles = nNeighbors / 2;
+		GGenerator::addEdgeBlocks(ret, nCycles + nNeighbors % 2, [nVertices, nCycles, seed](unsigned long block, const EdgeCallback& addEdge) {
+			std::vector<unsigned int> order(nVertices);
+			for (unsigned int i = 0; i < nVertices; i++) {
+				order[i] = i;
+			}
+			RandomStream rgen(seed, block);
+			std::shuffle(order.begin(), order.end(), rgen);
+			if (block < nCycles) {
+				for (unsigned int i = 0; i < nVertices; i++) {
+					addEdge(order[i], order[(i + 1) % nVertices]);
+				}
+			} else {
+				for (unsigned int i = 0; i + 1 < nVertices; i += 2) {
+					addEdge(order[i], order[i + 1]);
+				}
+			}
+		}, true);
+		return ret;
+	}
+
+	unsigned long GGenerator::getGridVertexCount(unsigned int dim, unsigned int width) {
+		unsigned long ret = 1;
+		for (unsigned int d = 0; d < dim; d++) {
+			if (width > 0 && ret > GGenerator::MAX_VERTICES / width) {
+				return GGenerator::MAX_VERTICES + 1;
+			}
+			ret *= width;
+		}
+		return ret;
+	}
+
+	/* Creates a grid with <width> vertices in each of <dim> dimensions and deletes every edge
+	 * with a probability of <deleted> percent. Vertices are numbered line by line along the
+	 * first dimension, blocks of lines draw from their own stream. */
+	SimpleGraph<unsigned int>* GGenerator::createRandomGrid(unsigned int dim, unsigned int width, unsigned int deleted, unsigned long seed) {
+		unsigned long nVertices = GGenerator::getGridVertexCount(dim, width);
+		if (nVertices > GGenerator::MAX_VERTICES) {
+			throw std::length_error("Grid exceeds the maximum number of vertices");
+		}
+		auto ret = new SimpleGraph<unsigned int>();
+		for (unsigned long i = 0; i < nVertices; i++) {
+			ret->addVertex(i);
+		}
+		if (nVertices < 2) {
+			return ret;
+		}
+		unsigned long threshold = GGenerator::toThreshold(deleted / 100.0);
+		unsigned long nLines = nVertices / width;
+		unsigned long linesPerBlock = std::max(1ul, (1ul << 20) / width / dim);
+		GGenerator::addEdgeBlocks(ret, (nLines + linesPerBlock - 1) / linesPerBlock, [=](unsigned long block, const EdgeCallback& addEdge) {
+			RandomStream rgen(seed, block);
+			unsigned long endLine = std::min(nLines, (block + 1) * linesPerBlock);
+			for (unsigned long v = block * linesPerBlock * width; v < endLine * width; v++) {
+				/* Connect v to its successor in every dimension */
+				unsigned long stride = 1, rest = v;
+				for (unsigned int d = 0; d < dim; d++) {
+					if (rest % width + 1 < width && rgen() >= threshold) {
+						addEdge(v, v + stride);
+					}
+					rest /= width;
+					stride *= width;
+				}
+			}
+		}, false);
+		return ret;
+	}
+
+	SimpleGraph<unsigned int>* GGenerator::createRandomGrid2d(unsigned int width, unsigned int deleted, unsigned long seed) {
+		return this->createRandomGrid(2, width, deleted, seed);
+	}
+
+	SimpleGraph<unsigned int>* GGenerator::createRandomGrid3d(unsigned int width, unsigned int deleted, unsigned long seed) {
+		return this->createRandomGrid(3, width, deleted, seed);
+	}
+
 	/* Implementation of the worst case graph proposed by Gabow
 	 * in "Efficient Implementation of Edmonds' Algorithm for
 	 * Maximum Matching on Graphs". The last vertex is moved to the front
@@ -75,6 +315,114 @@ namespace maxmatching {
 		return ret;
 	}
 
+	/* Computes the ports of nBlossoms consecutive nested blossoms and splits their cycles into
+	 * blocks. A blossom of depth 0 is a single vertex, which is its own port. One of depth d is an
+	 * odd cycle through the ports of <cycleLength> blossoms of depth d - 1, which are the only
+	 * vertices connecting them. Its port is the one of a random or of its first blossom. */
+	void GGenerator::makeNestedBlossoms(unsigned long nBlossoms, unsigned int depth, unsigned int cycleLength, bool randomPorts, unsigned long seed, std::vector<unsigned int>& ports, std::vector<CycleBlock>& blocks) {
+		const unsigned long gadgetsPerBlock = 1 << 16;
+		unsigned long nGadgets = nBlossoms;
+		for (unsigned int level = 0; level < depth; level++) {
+			nGadgets *= cycleLength;
+		}
+		/* Ports of all levels one after another, starting with the single vertices */
+		ports.reserve(nGadgets + nGadgets / (cycleLength - 1) + 1);
+		for (unsigned long i = 0; i < nGadgets; i++) {
+			ports.push_back(i);
+		}
+		unsigned long firstPort = 0;
+		std::uniform_int_distribution<unsigned int> draw(0, cycleLength - 1);
+		for (unsigned int level = 1; level <= depth; level++) {
+			nGadgets /= cycleLength;
+			for (unsigned long g = 0; g < nGadgets; g += gadgetsPerBlock) {
+				blocks.push_back({ firstPort + g * cycleLength, std::min(gadgetsPerBlock, nGadgets - g) });
+			}
+			RandomStream rgen(seed, level);
+			unsigned long nextPort = ports.size();
+			for (unsigned long g = 0; g < nGadgets; g++) {
+				ports.push_back(ports[firstPort + g * cycleLength + (randomPorts ? draw(rgen) : 0)]);
+			}
+			firstPort = nextPort;
+		}
+	}
+
+	void GGenerator::addCycles(const std::vector<unsigned int>& ports, const CycleBlock& block, unsigned int cycleLength, const EdgeCallback& addEdge) {
+		for (unsigned long g = 0; g < block.nGadgets; g++) {
+			const unsigned int* cycle = ports.data() + block.firstPort + g * cycleLength;
+			for (unsigned int i = 0; i < cycleLength; i++) {
+				addEdge(cycle[i], cycle[(i + 1) % cycleLength]);
+			}
+		}
+	}
+
+	/* Creates a blossom, which is nested <depth> times, with odd cycles of length 2 * <branching> + 1
+	 * and a pendant vertex at its port. The ports are random, so the degrees are spread over the graph
+	 * and a greedy matching by minimum degree runs into ties. Without any vertex, a blossom has a
+	 * unique perfect matching: the blossom containing the vertex is matched recursively, the ports of
+	 * the other ones in pairs along the cycle. Thus the pendant is part of a planted unique perfect
+	 * matching. The graph has (2 * <branching> + 1)^<depth> + 1 vertices and is created in linear time. */
+	SimpleGraph<unsigned int>* GGenerator::createNestedBlossoms(unsigned int depth, unsigned int branching, unsigned long seed) {
+		auto ret = new SimpleGraph<unsigned int>();
+		unsigned int cycleLength = 2 * std::max(branching, 1u) + 1;
+		unsigned long size = 1;
+		for (unsigned int level = 0; level < depth; level++) {
+			size *= cycleLength;
+		}
+		/* The pendant is the last vertex */
+		for (unsigned long i = 0; i <= size; i++) {
+			ret->addVertex(i);
+		}
+		std::vector<unsigned int> ports;
+		std::vector<CycleBlock> blocks;
+		GGenerator::makeNestedBlossoms(1, depth, cycleLength, true, seed, ports, blocks);
+		GGenerator::addEdgeBlocks(ret, blocks.size() + 1, [&ports, &blocks, cycleLength, size](unsigned long b, const EdgeCallback& addEdge) {
+			if (b < blocks.size()) {
+				GGenerator::addCycles(ports, blocks[b], cycleLength, addEdge);
+			} else {
+				addEdge(ports.back(), size);
+			}
+		}, false);
+		return ret;
+	}
+
+	/* Creates a path of <nBlossoms> blossoms, which consist of triangles nested <depth> times.
+	 * The port of every blossom is its first vertex and connected to the last vertex of the next
+	 * one, which is the deepest one, contained in the last triangle on every level. A pendant
+	 * vertex is attached to the deepest vertex of the first blossom and one to the port of the
+	 * last blossom. Augmenting paths enter the blossoms at their deepest vertex, so they traverse
+	 * all levels of nesting, which is adversarial for phase based algorithms like the one of
+	 * Micali and Vazirani. For an even number of blossoms, the graph has a planted unique perfect
+	 * matching, since every blossom without one vertex has one. */
+	SimpleGraph<unsigned int>* GGenerator::createBlossomChain(unsigned int nBlossoms, unsigned int depth) {
+		auto ret = new SimpleGraph<unsigned int>();
+		unsigned long size = 1;
+		for (unsigned int level = 0; level < depth; level++) {
+			size *= 3;
+		}
+		unsigned long nVertices = nBlossoms * size + 2;
+		for (unsigned long i = 0; i < nVertices; i++) {
+			ret->addVertex(i);
+		}
+		if (nBlossoms == 0) {
+			return ret;
+		}
+		std::vector<unsigned int> ports;
+		std::vector<CycleBlock> blocks;
+		GGenerator::makeNestedBlossoms(nBlossoms, depth, 3, false, 0, ports, blocks);
+		GGenerator::addEdgeBlocks(ret, blocks.size() + 1, [&ports, &blocks, nBlossoms, size, nVertices](unsigned long b, const EdgeCallback& addEdge) {
+			if (b < blocks.size()) {
+				GGenerator::addCycles(ports, blocks[b], 3, addEdge);
+				return;
+			}
+			for (unsigned long i = 0; i + 1 < nBlossoms; i++) {
+				addEdge(i * size, (i + 2) * size - 1);
+			}
+			addEdge(nVertices - 2, size - 1);
+			addEdge(nVertices - 1, (nBlossoms - 1) * size);
+		}, false);
+		return ret;
+	}
+
 	/* Creates a series of triangles (A_i,B_i,C_i)_i connected by
 	 * edges (X_i,X_{i+1}) exist for any X in {A,B,C} */
 	SimpleGraph<unsigned int>* GGenerator::createTrianglesA(unsigned int nTriangles) {
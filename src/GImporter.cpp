@@ -1,37 +1,200 @@
 #include "GImporter.h"
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+#ifdef HAS_ZSTD
+#include "boost/iostreams/filter/zstd.hpp"
+#include "boost/iostreams/filtering_stream.hpp"
+#include "boost/iostreams/device/back_inserter.hpp"
+#endif
 
 namespace maxmatching {
 	GImporter::GImporter() {}
 
 	GImporter::~GImporter() {}
 
+	/* Returns false if the varint does not end before end or has more than 64 bits */
+	bool GImporter::readVarint(const unsigned char*& it, const unsigned char* end, unsigned long& value) {
+		value = 0;
+		unsigned int shift = 0;
+		while (it < end && (*it & 0x80)) {
+			if (shift > 56) {
+				return false;
+			}
+			value |= (unsigned long)(*it & 0x7f) << shift;
+			shift += 7;
+			it++;
+		}
+		if (it == end || shift > 63) {
+			return false;
+		}
+		value |= (unsigned long)*it << shift;
+		it++;
+		return true;
+	}
+
 	SimpleGraph<unsigned int>* GImporter::importFile(const std::string& file) {
-		auto ret = new SimpleGraph<unsigned int>();
 		boost::iostreams::mapped_file mmap(file, boost::iostreams::mapped_file::readonly);
-		auto begin = mmap.const_data();
-		auto end = begin + mmap.size();
-		auto it = begin;
-		if ((it = static_cast<const char*>(memchr(it, '\n', end - it)))) {
-			std::string line(begin, it);
-			unsigned int nvs = std::atoi(line.c_str());
-			for (unsigned int i = 0; i < nvs; i++) {
-				ret->addVertex(i);
+		SimpleGraph<unsigned int>* ret = this->importData(mmap.const_data(), mmap.size());
+		mmap.close();
+		return ret;
+	}
+
+	SimpleGraph<unsigned int>* GImporter::importData(const char* data, unsigned long size) {
+		if (size >= sizeof(GExporter::MAGIC) && memcmp(data, GExporter::MAGIC, sizeof(GExporter::MAGIC)) == 0) {
+			return this->importCompressed(data, size);
+		} else {
+			return this->importText(data, size);
+		}
+	}
+
+	/* Every block decodes the adjacency lists of its vertices directly into their vectors.
+	 * The header, the offsets and every varint are checked against the size of the file,
+	 * so a truncated or corrupt file throws instead of reading out of bounds. */
+	SimpleGraph<unsigned int>* GImporter::importCompressed(const char* data, unsigned long size) {
+		struct Header {
+			char magic[4];
+			unsigned int version;
+			unsigned int codec;
+			unsigned int perBlock;
+			unsigned long nVertices;
+			unsigned long nBlocks;
+		} header;
+		if (size < sizeof(Header)) {
+			throw std::runtime_error("Truncated graph file");
+		}
+		memcpy(&header, data, sizeof(Header));
+		if (header.version != GExporter::VERSION) {
+			throw std::runtime_error("Unsupported graph file version");
+		}
+#ifndef HAS_ZSTD
+		if (header.codec != 0) {
+			throw std::runtime_error("Graph file is compressed with zstd, which is not supported by this build");
+		}
+#endif
+		if (header.perBlock == 0 || header.nVertices > std::numeric_limits<unsigned int>::max()
+			|| header.nBlocks != (header.nVertices + header.perBlock - 1) / header.perBlock) {
+			throw std::runtime_error("Corrupt graph file header");
+		}
+		unsigned long remaining = size - sizeof(Header);
+		if (header.nBlocks >= remaining / sizeof(unsigned long)) {
+			throw std::runtime_error("Truncated graph file");
+		}
+		std::vector<unsigned long> offsets(header.nBlocks + 1);
+		memcpy(offsets.data(), data + sizeof(Header), offsets.size() * sizeof(unsigned long));
+		remaining -= offsets.size() * sizeof(unsigned long);
+		for (unsigned long b = 0; b < header.nBlocks; b++) {
+			if (offsets[b] > offsets[b + 1]) {
+				throw std::runtime_error("Corrupt graph file offsets");
 			}
 		}
-		for (it++; it < end; it++) {
-			auto lineBegin = it;
-			if ((it = static_cast<const char*>(memchr(it, '\n', end - it)))) {
-				std::string line(lineBegin, it);
-				if (line.size() == 0) {
+		if (offsets[header.nBlocks] > remaining) {
+			throw std::runtime_error("Truncated graph file");
+		}
+		const char* blockData = data + sizeof(Header) + offsets.size() * sizeof(unsigned long);
+		auto ret = new SimpleGraph<unsigned int>();
+		for (unsigned int i = 0; i < header.nVertices; i++) {
+			ret->addVertex(i);
+		}
+		std::vector<std::vector<unsigned int>*> rows;
+		rows.reserve(header.nVertices);
+		for (auto& pair : ret->adjacencies) {
+			rows.push_back(pair.second);
+		}
+		/* Exceptions cannot leave the worker threads, the blocks only report corruption */
+		std::atomic<bool> corrupt(false);
+		Parallel::forEach(header.nBlocks, [&header, &offsets, &rows, &corrupt, blockData](unsigned long b) {
+			const unsigned char* it = reinterpret_cast<const unsigned char*>(blockData + offsets[b]);
+			const unsigned char* blockEnd = reinterpret_cast<const unsigned char*>(blockData + offsets[b + 1]);
+#ifdef HAS_ZSTD
+			std::string raw;
+			if (header.codec != 0) {
+				try {
+					boost::iostreams::filtering_ostream decompressor;
+					decompressor.push(boost::iostreams::zstd_decompressor());
+					decompressor.push(boost::iostreams::back_inserter(raw));
+					decompressor.write(blockData + offsets[b], offsets[b + 1] - offsets[b]);
+					decompressor.reset();
+				} catch (const std::exception&) {
+					corrupt = true;
+					return;
+				}
+				it = reinterpret_cast<const unsigned char*>(raw.data());
+				blockEnd = it + raw.size();
+			}
+#endif
+			unsigned long end = std::min(header.nVertices, (b + 1) * header.perBlock);
+			for (unsigned long v = b * header.perBlock; v < end; v++) {
+				std::vector<unsigned int>& row = *rows[v];
+				unsigned long degree, zigzag, gap;
+				/* Every neighbor takes at least one byte, which bounds the degree */
+				if (!GImporter::readVarint(it, blockEnd, degree) || degree > (unsigned long)(blockEnd - it)) {
+					corrupt = true;
+					return;
+				}
+				row.resize(degree);
+				if (row.empty()) {
 					continue;
 				}
-				int from, to;
-				std::sscanf(line.c_str(), "%u %u", &from, &to);
-				ret->addEdgeSym(from, to);
+				if (!GImporter::readVarint(it, blockEnd, zigzag)) {
+					corrupt = true;
+					return;
+				}
+				unsigned long w = v + ((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+				if (w >= header.nVertices) {
+					corrupt = true;
+					return;
+				}
+				row[0] = w;
+				for (unsigned long i = 1; i < row.size(); i++) {
+					if (!GImporter::readVarint(it, blockEnd, gap) || gap >= header.nVertices - w) {
+						corrupt = true;
+						return;
+					}
+					w += gap;
+					row[i] = w;
+				}
 			}
+		});
+		if (corrupt) {
+			delete(ret);
+			throw std::runtime_error("Corrupt graph file block");
+		}
+		return ret;
+	}
+
+	SimpleGraph<unsigned int>* GImporter::importText(const char* data, unsigned long size) {
+		auto ret = new SimpleGraph<unsigned int>();
+		auto begin = data;
+		auto end = begin + size;
+		auto it = static_cast<const char*>(memchr(begin, '\n', size));
+		if (it == nullptr) {
+			delete(ret);
+			throw std::runtime_error("Truncated graph file");
+		}
+		std::string firstLine(begin, it);
+		unsigned int nvs = std::atoi(firstLine.c_str());
+		for (unsigned int i = 0; i < nvs; i++) {
+			ret->addVertex(i);
+		}
+		for (it++; it < end; it++) {
+			auto lineBegin = it;
+			/* The last line may end without a line break */
+			if (!(it = static_cast<const char*>(memchr(it, '\n', end - it)))) {
+				it = end;
+			}
+			std::string line(lineBegin, it);
+			if (line.size() == 0) {
+				continue;
+			}
+			unsigned int from, to;
+			if (std::sscanf(line.c_str(), "%u %u", &from, &to) != 2 || from >= nvs || to >= nvs) {
+				delete(ret);
+				throw std::runtime_error("Corrupt graph file edge");
+			}
+			ret->addEdgeSym(from, to);
 		}
-		mmap.close();
 		ret->cleanUp();
 		return ret;
 	}
-}
\ No newline at end of file
+}
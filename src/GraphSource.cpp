@@ -19,18 +19,27 @@ namespace maxmatching {
 		: GraphSource(1)
 		, source(source)
 		, nNeighbors(nNeighbors) {}
-	/* Reads a tsp file and buffers the result in a g file.
-	 * If a g file with the name already exists, uses this one instead. */
+	/* Reads a tsp file and buffers the result in the instance store. The size and
+	 * modification time of the tsp file are part of the key, so a changed file is parsed again. */
 	SimpleGraph<unsigned int>* FileGraphSource::getNext() {
 		if (this->size > 0) {
-			std::string bufferFile = Files::inputFileToBufferFile(source, this->nNeighbors);
-			if (!Files::isFile(bufferFile)) {
-				Files::makePathToFile(bufferFile);
-				TSPParser parser;
-				parser.parseFile(source, bufferFile, this->nNeighbors);
+			std::stringstream parameters;
+			parameters << "File_" << this->source << "_" << this->nNeighbors << "_"
+				<< boost::filesystem::file_size(this->source) << "_"
+				<< boost::filesystem::last_write_time(this->source);
+			unsigned long long key = InstanceStore::makeKey(Filesystem, parameters.str());
+			SimpleGraph<unsigned int>* ret = InstanceStore::load(key);
+			if (ret == nullptr) {
+				/* The parser writes the text format, which is read and compressed in place */
+				InstanceStore::add(key, this->printSource(), [this, &ret](const std::string& file) {
+					TSPParser parser;
+					parser.parseFile(this->source, file, this->nNeighbors);
+					GImporter importer;
+					ret = importer.importFile(file);
+					GExporter exporter;
+					exporter.writeFile(file, ret);
+				});
 			}
-			GImporter importer;
-			auto ret = importer.importFile(bufferFile);
 			this->size--;
 			return ret;
 		}
@@ -90,27 +99,24 @@ namespace maxmatching {
 	}
 
 
-	GeneratorGraphSource::GeneratorGraphSource(std::string tmpFile, std::string string, std::function<SimpleGraph<unsigned int>* (GGenerator)> generator)
+	GeneratorGraphSource::GeneratorGraphSource(unsigned long long key, std::string string, std::function<SimpleGraph<unsigned int>* (GGenerator)> generator)
 		: GraphSource(1)
-		, tmpFile(tmpFile)
+		, key(key)
 		, string(string)
 		, generator(generator) {}
 	GeneratorGraphSource::~GeneratorGraphSource() {}
-	/* Creates a graph using the provided generator. Buffers the result in a g file.
-	 * If a g file with the name already exists, uses this one instead. */
+	/* Creates a graph using the provided generator and buffers the result in the instance store.
+	 * If the store already contains the instance, uses this one instead. */
 	SimpleGraph<unsigned int>* GeneratorGraphSource::getNext() {
 		if (this->size > 0) {
-			SimpleGraph<unsigned int>* ret;
-			if (!this->tmpFile.empty() && Files::isFile(this->tmpFile)) {
-				GImporter importer;
-				ret = importer.importFile(this->tmpFile);
-			} else {
+			SimpleGraph<unsigned int>* ret = InstanceStore::load(this->key);
+			if (ret == nullptr) {
 				GGenerator gen;
 				ret = generator(gen);
-				if (!this->tmpFile.empty()) {
+				InstanceStore::add(this->key, this->string, [ret](const std::string& file) {
 					GExporter exporter;
-					exporter.writeFile(tmpFile, ret);
-				}
+					exporter.writeFile(file, ret);
+				});
 			}
 			this->size--;
 			return ret;
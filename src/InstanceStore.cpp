@@ -0,0 +1,220 @@
+#include "InstanceStore.h"
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <stdexcept>
+#include "boost/iostreams/device/mapped_file.hpp"
+#include "Tools.h"
+#include "GExporter.h"
+#include "GImporter.h"
+#include "Job.h"
+
+namespace maxmatching {
+	const std::string InstanceStore::DIR = "assets/tmp/store";
+
+	InstanceStore::InstanceStore() {}
+	InstanceStore::~InstanceStore() {}
+
+	/* Increase the version of a source, whenever a change of its generator or parser
+	 * results in other graphs for the same parameters and seed. Instances of the old
+	 * version are not found anymore and evicted eventually. */
+	unsigned int InstanceStore::getVersion(SourceType type) {
+		switch (type) {
+		default:
+			return 1;
+		}
+	}
+
+	std::string InstanceStore::toHex(unsigned long long value) {
+		std::stringstream ret;
+		ret << std::hex;
+		ret.width(16);
+		ret.fill('0');
+		ret << value;
+		return ret.str();
+	}
+
+	std::string InstanceStore::getFile(unsigned long long key) {
+		return InstanceStore::DIR + "/" + InstanceStore::toHex(key) + ".g";
+	}
+
+	std::string InstanceStore::getManifest(unsigned long long key) {
+		return InstanceStore::DIR + "/" + InstanceStore::toHex(key) + ".meta";
+	}
+
+	/* Unique name in the same directory, so renaming it is atomic */
+	std::string InstanceStore::makeTemporary(const std::string& file) {
+		return file + "." + boost::filesystem::unique_path("%%%%%%%%%%%%").string() + ".tmp";
+	}
+
+	/* 64 bit FNV-1a hash over the FNV-1a hashes of the chunks of the content.
+	 * The chunks are hashed in parallel, so checking an instance costs little
+	 * compared to decoding it. */
+	unsigned long long InstanceStore::checksum(const char* data, unsigned long size) {
+		const unsigned long chunkSize = 1ul << 20;
+		unsigned long nChunks = (size + chunkSize - 1) / chunkSize;
+		std::vector<unsigned long long> hashes(nChunks);
+		Parallel::forEach(nChunks, [data, size, chunkSize, &hashes](unsigned long c) {
+			unsigned long long hash = 14695981039346656037ull;
+			for (unsigned long i = c * chunkSize; i < std::min(size, (c + 1) * chunkSize); i++) {
+				hash ^= static_cast<unsigned char>(data[i]);
+				hash *= 1099511628211ull;
+			}
+			hashes[c] = hash;
+		});
+		unsigned long long hash = 14695981039346656037ull;
+		for (unsigned long long chunkHash : hashes) {
+			for (unsigned int i = 0; i < sizeof(chunkHash); i++) {
+				hash ^= (chunkHash >> (8 * i)) & 0xff;
+				hash *= 1099511628211ull;
+			}
+		}
+		return hash;
+	}
+
+	void InstanceStore::open(unsigned long capacity) {
+		using namespace boost::filesystem;
+		Files::makePath(InstanceStore::DIR);
+		struct Instance {
+			std::time_t used;
+			unsigned long size;
+			path file;
+			path manifest;
+		};
+		std::vector<Instance> instances;
+		std::time_t now = std::time(nullptr);
+		boost::system::error_code error;
+		for (auto& entry : boost::make_iterator_range(directory_iterator(InstanceStore::DIR), {})) {
+			path file = entry.path();
+			std::string extension = file.extension().string();
+			if (extension == ".tmp") {
+				if (now - last_write_time(file, error) > InstanceStore::STALE_SECONDS) {
+					remove(file, error);
+				}
+			} else if (extension == ".meta") {
+				if (!exists(path(file).replace_extension(".g"))) {
+					remove(file, error);
+				}
+			} else if (extension == ".g") {
+				path manifest = path(file).replace_extension(".meta");
+				if (!exists(manifest)) {
+					/* The manifest may still be written by a concurrent add */
+					if (now - last_write_time(file, error) > InstanceStore::STALE_SECONDS) {
+						remove(file, error);
+					}
+					continue;
+				}
+				Instance instance;
+				instance.used = last_write_time(manifest, error);
+				instance.size = file_size(file, error);
+				instance.file = file;
+				instance.manifest = manifest;
+				instances.push_back(instance);
+			}
+		}
+		if (capacity == 0) {
+			return;
+		}
+		unsigned long total = 0;
+		for (auto& instance : instances) {
+			total += instance.size;
+		}
+		std::sort(instances.begin(), instances.end(), [](const Instance& a, const Instance& b) {
+			return a.used < b.used;
+		});
+		for (unsigned int i = 0; i < instances.size() && total > capacity; i++) {
+			remove(instances[i].manifest, error);
+			remove(instances[i].file, error);
+			total -= instances[i].size;
+		}
+	}
+
+	/* 64 bit FNV-1a hash over the source, its version, the parameters and the file format.
+	 * The source is identified by its command line flag, since the ordinals of the enum
+	 * change whenever a source is added or removed.
+	 * Builds with and without zstd do not share instances, since they cannot read each other's. */
+	unsigned long long InstanceStore::makeKey(SourceType type, const std::string& parameters) {
+		std::stringstream fields;
+		fields << Job::getSourceFlag(type) << '\0'
+			<< InstanceStore::getVersion(type) << '\0'
+			<< parameters << '\0'
+			<< GExporter::VERSION << '\0'
+			<< GExporter::CODEC;
+		unsigned long long hash = 14695981039346656037ull;
+		for (char c : fields.str()) {
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	/* The manifest line holds the size, the checksum as 16 hex digits, the modification time
+	 * of the instance in seconds, the creation time in milliseconds and the description.
+	 * The size and modification time are checked before mapping the instance, the checksum
+	 * on the mapped content right before decoding it. */
+	SimpleGraph<unsigned int>* InstanceStore::load(unsigned long long key) {
+		std::string file = InstanceStore::getFile(key);
+		std::string manifest = InstanceStore::getManifest(key);
+		std::ifstream in(manifest);
+		unsigned long size, created;
+		std::string checksumHex;
+		std::time_t modified;
+		if (!(in >> size >> checksumHex >> modified >> created) || checksumHex.size() != 16
+			|| checksumHex.find_first_not_of("0123456789abcdef") != std::string::npos) {
+			return nullptr;
+		}
+		in.close();
+		boost::system::error_code error;
+		unsigned long actualSize = boost::filesystem::file_size(file, error);
+		if (error || actualSize != size || size == 0) {
+			return nullptr;
+		}
+		std::time_t actualModified = boost::filesystem::last_write_time(file, error);
+		if (error || actualModified != modified) {
+			return nullptr;
+		}
+		SimpleGraph<unsigned int>* ret = nullptr;
+		try {
+			boost::iostreams::mapped_file_source mmap(file);
+			if (mmap.size() == size && InstanceStore::checksum(mmap.data(), size) == std::stoull(checksumHex, nullptr, 16)) {
+				GImporter importer;
+				ret = importer.importData(mmap.data(), size);
+			}
+			mmap.close();
+		} catch (const std::exception&) {
+			/* Not readable or corrupt, the caller creates it again */
+			return nullptr;
+		}
+		if (ret != nullptr) {
+			boost::filesystem::last_write_time(manifest, std::time(nullptr), error);
+		}
+		return ret;
+	}
+
+	/* The instance is moved into the store before its manifest, a concurrent reader
+	 * seeing the instance with an outdated manifest only creates it once more.
+	 * Renaming keeps the modification time recorded in the manifest. */
+	void InstanceStore::add(unsigned long long key, const std::string& description, const std::function<void(const std::string&)>& writer) {
+		Files::makePath(InstanceStore::DIR);
+		std::string file = InstanceStore::getFile(key);
+		std::string tmpFile = InstanceStore::makeTemporary(file);
+		writer(tmpFile);
+		unsigned long size = boost::filesystem::file_size(tmpFile);
+		unsigned long long hash = InstanceStore::checksum(nullptr, 0);
+		if (size > 0) {
+			boost::iostreams::mapped_file_source mmap(tmpFile);
+			hash = InstanceStore::checksum(mmap.data(), size);
+			mmap.close();
+		}
+		std::time_t modified = boost::filesystem::last_write_time(tmpFile);
+		boost::filesystem::rename(tmpFile, file);
+		std::string manifest = InstanceStore::getManifest(key);
+		std::string tmpManifest = InstanceStore::makeTemporary(manifest);
+		std::ofstream out(tmpManifest);
+		out << size << " " << InstanceStore::toHex(hash) << " " << modified << " " << Time::currentTimeMillis() << " " << description << "\n";
+		out.close();
+		boost::filesystem::rename(tmpManifest, manifest);
+	}
+}
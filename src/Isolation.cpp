@@ -0,0 +1,126 @@
+#include "Isolation.h"
+#include <iostream>
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "Tools.h"
+
+namespace maxmatching {
+	bool Isolation::enabled = false;
+	unsigned int Isolation::timeout = 0;
+	unsigned long Isolation::memoryLimit = 0;
+
+	Isolation::Isolation() {}
+	Isolation::~Isolation() {}
+
+	void Isolation::setEnabled(unsigned int timeout, unsigned long memoryLimit) {
+		Isolation::enabled = true;
+		Isolation::timeout = timeout;
+		Isolation::memoryLimit = memoryLimit;
+	}
+
+	bool Isolation::isEnabled() {
+		return Isolation::enabled;
+	}
+
+	IsolationResult Isolation::run(const std::function<int(std::string&)>& task, int& code, std::string& output) {
+		output.clear();
+		int fds[2];
+		if (pipe(fds) != 0) {
+			throw std::string("Unable to create a pipe for the child process");
+		}
+		/* Buffered output would be written twice otherwise */
+		std::cout.flush();
+		std::cerr.flush();
+		pid_t pid = fork();
+		if (pid < 0) {
+			close(fds[0]);
+			close(fds[1]);
+			throw std::string("Unable to fork a child process");
+		}
+		if (pid == 0) {
+			close(fds[0]);
+			if (Isolation::memoryLimit > 0) {
+				struct rlimit limit;
+				limit.rlim_cur = Isolation::memoryLimit * 1024 * 1024;
+				limit.rlim_max = limit.rlim_cur;
+				setrlimit(RLIMIT_AS, &limit);
+			}
+			std::string result;
+			int ret = task(result);
+			const char* data = result.data();
+			std::size_t remaining = result.size();
+			while (remaining > 0) {
+				ssize_t written = write(fds[1], data, remaining);
+				if (written < 0) {
+					if (errno == EINTR) {
+						continue;
+					}
+					break;
+				}
+				data += written;
+				remaining -= written;
+			}
+			close(fds[1]);
+			std::cout.flush();
+			std::cerr.flush();
+			/* Skip destructors and atexit handlers, which belong to the parent */
+			_exit(ret);
+		}
+		close(fds[1]);
+		/* The deadline is taken from the monotonic clock, so changes of the system time do not matter */
+		unsigned long deadline = Isolation::timeout > 0
+			? Time::currentTimeNanos() + Isolation::timeout * 1000000000ul
+			: 0;
+		bool timedOut = false;
+		char buffer[4096];
+		while (true) {
+			int wait = -1;
+			if (deadline > 0) {
+				unsigned long now = Time::currentTimeNanos();
+				if (now >= deadline) {
+					timedOut = true;
+					break;
+				}
+				/* Rounded up, so poll does not return just before the deadline */
+				wait = (deadline - now + 999999ul) / 1000000ul;
+			}
+			struct pollfd pfd = { fds[0], POLLIN, 0 };
+			int ready = poll(&pfd, 1, wait);
+			if (ready < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				break;
+			} else if (ready == 0) {
+				continue;
+			}
+			ssize_t n = read(fds[0], buffer, sizeof(buffer));
+			if (n < 0 && errno == EINTR) {
+				continue;
+			} else if (n <= 0) {
+				/* The child closed the pipe */
+				break;
+			}
+			output.append(buffer, n);
+		}
+		close(fds[0]);
+		if (timedOut) {
+			kill(pid, SIGKILL);
+		}
+		int status = 0;
+		while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+		if (timedOut) {
+			code = 0;
+			return IsolationTimeout;
+		} else if (WIFSIGNALED(status)) {
+			code = WTERMSIG(status);
+			return IsolationSignaled;
+		}
+		code = WEXITSTATUS(status);
+		return IsolationExited;
+	}
+}
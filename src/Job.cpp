@@ -1,5 +1,30 @@
 #include "Job.h"
 
+/* Every graph source with its command line flag and the number of its arguments */
+#define JOB_SOURCE_FLAGS(F) \
+/**/	F("-f", Filesystem, 2) \
+/**/	F("-Gr", RandomBoost, 2) \
+/**/	F("-Grd", RandomDimacs, 2) \
+/**/	F("-Grt", RandomTriangle, 1) \
+/**/	F("-Gre2", RandomEuclid2d, 2) \
+/**/	F("-Gre3", RandomEuclid3d, 2) \
+/**/	F("-Gre10", RandomEuclid10d, 2) \
+/**/	F("-Gre20", RandomEuclid20d, 2) \
+/**/	F("-Grm", RandomRMat, 2) \
+/**/	F("-Grp", RandomBarabasiAlbert, 2) \
+/**/	F("-Grr", RandomRegular, 2) \
+/**/	F("-Grg2", RandomGrid2d, 2) \
+/**/	F("-Grg3", RandomGrid3d, 2) \
+/**/	F("-Gg", WorstCaseGabow, 1) \
+/**/	F("-Gnb", NestedBlossoms, 2) \
+/**/	F("-Gbc", BlossomChain, 2) \
+/**/	F("-Gta", TriangleSeriesA, 1) \
+/**/	F("-Gtb", TriangleSeriesB, 1) \
+/**/	F("-Ghc", HoneyCombs, 2) \
+/**/	F("-Ghcp", HoneyCombsPlus, 2) \
+/**/	F("-Ghcc", HoneyCombsCaps, 2) \
+/**/	F("-Ghci", HoneyCombsInner, 2)
+
 namespace maxmatching {
 	Job::Job()
 		: source(new VoidGraphSource)
@@ -8,7 +33,8 @@ namespace maxmatching {
 		, iterations(0)
 		, solver(MultiTrees)
 		, solverArg1(0)
-		, solverArg2(0) {}
+		, solverArg2(0)
+		, solvers() {}
 
 
 	Job::~Job() {
@@ -42,22 +68,22 @@ namespace maxmatching {
 	}
 
 
+	void Job::selectSolver(const SolverConfig& config) {
+		this->solver = config.type;
+		this->solverArg1 = config.arg1;
+		this->solverArg2 = config.arg2;
+	}
+
 	std::string Job::createCsvHeader() {
 		std::stringstream ret;
 		ret << "Source, Seed, Shuffle, Iterations, Solver, Solver arg 1, Solver arg 2";
 		return ret.str();
 	}
 
-	std::string Job::createCsvData() {
-		std::stringstream ret;
-		ret << source->printSource()
-			<< ", " << this->seed
-			<< ", " << this->shuffle
-			<< ", " << this->iterations
-			<< ", ";
+	std::string Job::getSolverName() {
 		switch (solver) {
 #define JOB_PRINT_CASE(TYPE) \
-	case TYPE: ret << #TYPE; break;
+	case TYPE: return #TYPE;
 			JOB_PRINT_CASE(MultiTrees);
 			JOB_PRINT_CASE(MetaGraphs);
 			JOB_PRINT_CASE(MetaGraphsWR);
@@ -74,11 +100,77 @@ namespace maxmatching {
 #endif
 #undef JOB_PRINT_CASE
 		}
+		return "";
+	}
+
+	std::string Job::createCsvData() {
+		std::stringstream ret;
+		ret << source->printSource()
+			<< ", " << this->seed
+			<< ", " << this->shuffle
+			<< ", " << this->iterations
+			<< ", " << this->getSolverName();
 		ret << ", " << solverArg1;
 		ret << ", " << solverArg2;
 		return ret.str();
 	}
 
+	bool Job::findSourceFlag(const std::string& flag, SourceType& type, unsigned int& nArgs) {
+#define JOB_SOURCE_FLAG(FLAG, TYPE, N_ARGS) \
+/**/	if (flag == FLAG) { \
+/**/		type = TYPE; \
+/**/		nArgs = N_ARGS; \
+/**/		return true; \
+/**/	}
+		JOB_SOURCE_FLAGS(JOB_SOURCE_FLAG)
+#undef JOB_SOURCE_FLAG
+		return false;
+	}
+
+	std::string Job::getSourceFlag(SourceType type) {
+#define JOB_SOURCE_FLAG(FLAG, TYPE, N_ARGS) \
+/**/	if (type == TYPE) { \
+/**/		return FLAG; \
+/**/	}
+		JOB_SOURCE_FLAGS(JOB_SOURCE_FLAG)
+#undef JOB_SOURCE_FLAG
+		return "";
+	}
+
+	bool Job::findSolverFlag(const std::string& flag, SolverType& type, unsigned int& nArgs) {
+#define JOB_SOLVER_FLAG(FLAG, TYPE, N_ARGS) \
+/**/	if (flag == FLAG) { \
+/**/		type = TYPE; \
+/**/		nArgs = N_ARGS; \
+/**/		return true; \
+/**/	}
+		JOB_SOLVER_FLAG("-mt", MultiTrees, 0);
+		JOB_SOLVER_FLAG("-mg", MetaGraphs, 0);
+		JOB_SOLVER_FLAG("-mgwr", MetaGraphsWR, 1);
+		JOB_SOLVER_FLAG("-mgqpt", MetaGraphsQPT, 2);
+		JOB_SOLVER_FLAG("-eb", EdmondsBoost, 0);
+		JOB_SOLVER_FLAG("-ebp", EdmondsBoost, 2);
+#ifdef HAS_LEMON
+		JOB_SOLVER_FLAG("-el", EdmondsLemon, 0);
+#endif
+#ifdef HAS_BLOSSOM_IV
+		JOB_SOLVER_FLAG("-biv", BlossomIV, 1);
+#endif
+#ifdef HAS_BLOSSOM_V
+		JOB_SOLVER_FLAG("-bv", BlossomV, 1);
+#endif
+#undef JOB_SOLVER_FLAG
+		return false;
+	}
+
+	void Job::expandSolver(SolverType type, IntStepper args1, IntStepper args2, std::vector<SolverConfig>& configs) {
+		for (unsigned int arg1 : args1) {
+			for (unsigned int arg2 : args2) {
+				configs.push_back({ type, arg1, arg2 });
+			}
+		}
+	}
+
 	JobCollection::JobCollection()
 		: Job()
 		, jobs() {}
@@ -96,6 +188,7 @@ namespace maxmatching {
 		job->shuffle = this->shuffle;
 		job->solver = this->solver;
 		job->iterations = this->iterations;
+		job->solvers = this->solvers;
 	}
 	bool JobCollection::isCompound() {
 		return true;
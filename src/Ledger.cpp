@@ -0,0 +1,161 @@
+#include "Ledger.h"
+#include <sstream>
+
+namespace maxmatching {
+	std::ofstream* Ledger::out = nullptr;
+	std::unordered_map<unsigned long long, LedgerEntry> Ledger::entries;
+
+	Ledger::Ledger() {}
+	Ledger::~Ledger() {}
+
+	/* Each line holds the key as 16 hex digits, followed by either
+	 * "OK <matching> <measurement as hex>" or the failure status. */
+	void Ledger::open(const std::string& file) {
+		Ledger::close();
+		Ledger::entries.clear();
+		bool terminated = true;
+		std::ifstream in(file);
+		std::string line;
+		while (std::getline(in, line)) {
+			/* A line without a line break was cut off by a killed run */
+			if (in.eof()) {
+				terminated = false;
+				break;
+			}
+			std::istringstream fields(line);
+			std::string keyHex, status;
+			if (!(fields >> keyHex >> status) || keyHex.size() != 16
+				|| keyHex.find_first_not_of("0123456789abcdef") != std::string::npos) {
+				continue;
+			}
+			unsigned long long key = std::stoull(keyHex, nullptr, 16);
+			LedgerEntry entry;
+			entry.matching = -1;
+			if (status == "OK") {
+				std::string measurementHex;
+				if (!(fields >> entry.matching >> measurementHex)
+					|| !Ledger::fromHex(measurementHex, entry.measurement)) {
+					continue;
+				}
+			} else {
+				entry.failure = status;
+			}
+			Ledger::entries[key] = entry;
+		}
+		in.close();
+		Ledger::out = new std::ofstream(file, std::ios::app);
+		if (!terminated) {
+			*Ledger::out << "\n";
+		}
+	}
+
+	void Ledger::close() {
+		if (Ledger::out != nullptr) {
+			Ledger::out->close();
+			delete(Ledger::out);
+			Ledger::out = nullptr;
+		}
+	}
+
+	bool Ledger::isEnabled() {
+		return Ledger::out != nullptr;
+	}
+
+	/* 64 bit FNV-1a hash over all fields identifying an iteration */
+	unsigned long long Ledger::makeKey(const std::string& source, const std::string& solver, unsigned int solverArg1, unsigned int solverArg2, unsigned long seed, bool shuffle, unsigned int iteration) {
+		std::stringstream fields;
+		fields << source << '\0'
+			<< solver << '\0'
+			<< solverArg1 << '\0'
+			<< solverArg2 << '\0'
+			<< seed << '\0'
+			<< shuffle << '\0'
+			<< iteration;
+		unsigned long long hash = 14695981039346656037ull;
+		for (char c : fields.str()) {
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	const LedgerEntry* Ledger::find(unsigned long long key) {
+		auto it = Ledger::entries.find(key);
+		if (it == Ledger::entries.end()) {
+			return nullptr;
+		}
+		return &it->second;
+	}
+
+	void Ledger::addResult(unsigned long long key, int matching, const std::string& measurement) {
+		LedgerEntry entry;
+		entry.matching = matching;
+		entry.measurement = measurement;
+		Ledger::write(key, entry);
+	}
+
+	void Ledger::addFailure(unsigned long long key, const std::string& failure) {
+		LedgerEntry entry;
+		entry.failure = failure;
+		entry.matching = -1;
+		Ledger::write(key, entry);
+	}
+
+	/* Writes the entry as a single line and flushes it,
+	 * so it survives the process being killed. */
+	void Ledger::write(unsigned long long key, const LedgerEntry& entry) {
+		Ledger::entries[key] = entry;
+		if (Ledger::out == nullptr) {
+			return;
+		}
+		std::stringstream line;
+		line << std::hex;
+		line.width(16);
+		line.fill('0');
+		line << key << std::dec << " ";
+		if (entry.failure.empty()) {
+			line << "OK " << entry.matching << " " << Ledger::toHex(entry.measurement);
+		} else {
+			line << entry.failure;
+		}
+		line << "\n";
+		*Ledger::out << line.str();
+		Ledger::out->flush();
+	}
+
+	std::string Ledger::toHex(const std::string& data) {
+		static const char digits[] = "0123456789abcdef";
+		std::string ret;
+		ret.reserve(data.size() * 2);
+		for (char c : data) {
+			unsigned char b = static_cast<unsigned char>(c);
+			ret.push_back(digits[b >> 4]);
+			ret.push_back(digits[b & 0xf]);
+		}
+		return ret;
+	}
+
+	bool Ledger::fromHex(const std::string& hex, std::string& data) {
+		if (hex.size() % 2 != 0) {
+			return false;
+		}
+		data.clear();
+		data.reserve(hex.size() / 2);
+		for (unsigned int i = 0; i < hex.size(); i += 2) {
+			int b = 0;
+			for (unsigned int j = i; j < i + 2; j++) {
+				char c = hex[j];
+				b <<= 4;
+				if (c >= '0' && c <= '9') {
+					b |= c - '0';
+				} else if (c >= 'a' && c <= 'f') {
+					b |= c - 'a' + 10;
+				} else {
+					return false;
+				}
+			}
+			data.push_back(static_cast<char>(b));
+		}
+		return true;
+	}
+}
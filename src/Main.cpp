@@ -5,7 +5,14 @@
 #include <functional>
 #include <stdarg.h>
 #include <limits.h>
+#include <csignal>
+#include <cstring>
 #include "Statistics.h"
+#include "Trace.h"
+#include "EventTrace.h"
+#include "Isolation.h"
+#include "Ledger.h"
+#include "InstanceStore.h"
 #include "List.h"
 #include "Vertex.h"
 #include "MultiTreeSolver.h"
@@ -34,10 +41,22 @@
 #include "TypeEnums.h"
 #include "IntStepper.h"
 #include "Job.h"
+#include "Suite.h"
+#include "SolverRegistry.h"
+#include "MatchingVerifier.h"
+#include "MatchingWriter.h"
 
 using namespace maxmatching;
 
 bool printBaseGraphs = false;
+bool verifyMatchings = false;
+/* If set, the next successful iteration stores its matching in mates */
+bool captureMates = false;
+std::vector<unsigned int> mates;
+/* Initiator probabilities of R-MAT graphs in percent, the fourth one is 100 minus their sum */
+unsigned int rmatA = 57, rmatB = 19, rmatC = 19;
+/* Capacity of the instance store in megabytes, 0 disables the eviction */
+unsigned long storeCapacity = 4096;
 std::ofstream csv("measure.csv");
 
 template<typename VType, typename LType>
@@ -65,117 +84,193 @@ void printMatching(Solver<VType, LType> solver) {
 	delete(labels);
 }
 
-/* Executes a job specified by the user input. If it is a compound job,
- * every job is executed one after another. All data is printed to the csv ofstream. */
+/* Exit codes of a single iteration */
+enum IterationStatus {
+	IterationOk = 0,
+	IterationUnknownError = 1,
+	IterationStringError = 2,
+	IterationException = 3,
+	IterationOutOfMemory = 4,
+	IterationInvalidMatching = 5
+};
+
+/* Runs a single iteration of a job on the current graph as one measurement
+ * and stores the size of the computed matching. */
 template<typename SType, typename VType>
-void performJob(Job& job, bool isSub) {
-	/* The first call will print a header row for the csv data */
-	if (!isSub) {
-		csv << job.createCsvHeader() << ", "
-			<< "#Vertices, "
-			<< "#Edges, "
-			<< Statistics::createCsvHeader() << ", "
-			<< "Matching\n";
+IterationStatus runIteration(Job& job, SimpleGraph<unsigned int>* graph, int& matching) {
+	SType::prepareScratch();
+	Statistics::startMeasure();
+	VType::resetIds();
+	Solver<VType, unsigned int>* solver = new SType(job.solverArg1, job.solverArg2);
+	Statistics::startPhase(PhaseReadGraph);
+	solver->readGraph(graph);
+	Statistics::stopPhase(PhaseReadGraph);
+	DEBUG("Pre calculation\n");
+	/* Time is measured after reading the graph, since building
+	 * the data structures is not part of the algorithms.
+	 * The build time is reported separately as the read graph phase,
+	 * so both can be compared end to end. */
+	Statistics::startTimer();
+	try {
+		solver->calculateMaxMatching();
+	} catch (const std::bad_alloc & ex) {
+		std::cerr << "Crashed! Reason: Out of memory\n"; std::flush(std::cout);
+		EventTrace::dump(std::cerr);
+		return IterationOutOfMemory;
+	} catch (const std::exception & ex) {
+		std::cerr << "Crashed! Reason: " << ex.what() << "\n"; std::flush(std::cout);
+		EventTrace::dump(std::cerr);
+		return IterationException;
+	} catch (const std::string & ex) {
+		std::cerr << "Crashed! Reason: " << ex << "\n"; std::flush(std::cout);
+		EventTrace::dump(std::cerr);
+		return IterationStringError;
+	} catch (...) {
+		std::cerr << "Crashed! Reason: ???\n"; std::flush(std::cout);
+		EventTrace::dump(std::cerr);
+		return IterationUnknownError;
 	}
-	/* Compound jobs get split up. */
-	if (job.isCompound()) {
-		Job* subJob = job.nextSubJob();
-		while (subJob != nullptr) {
-			performJob<SType, VType>(*subJob, true);
-			delete(subJob);
-			subJob = job.nextSubJob();
+	auto reps = solver->getMatchingRepresentatives();
+	/* Stop the timer after a list containing the matching edges representatives
+	 * (ends of a matching edge) are obtained, since this is the result of the algorithms. */
+	Statistics::pauseTimer();
+	matching = reps->size();
+	delete(reps);
+	DEBUG("Post calculation\n");
+	/* Stop the current measure, thus creating an entry for the statistics.
+	 * The mates and labels are taken afterwards, so -m and -v do not change
+	 * the time or the allocations of the measure. */
+	Statistics::stopMeasure();
+	if (captureMates) {
+		mates.resize(graph->getVertexCount());
+		solver->getMatchingMates(mates.data());
+	}
+	std::vector<std::pair<unsigned int, unsigned int>>* labels = nullptr;
+	if (verifyMatchings) {
+		labels = solver->getMatchingLabels();
+	}
+	/* Clean up. Using fresh solvers and vertices every iterations
+	 * prevents the algorithms from cheating and reusing some information. */
+	solver->clearVertices();
+	delete(solver);
+	/* The verification is not part of the measure */
+	if (labels != nullptr) {
+		std::string error;
+		bool valid = MatchingVerifier<unsigned int>::verify(graph, *labels, error);
+		delete(labels);
+		if (!valid) {
+			std::cerr << "Invalid matching! Reason: " << error << "\n";
+			return IterationInvalidMatching;
 		}
-	} else {
-		/* Iterate over all graphs provided by the source */
-		auto graph = job.getSource().getNext();
-		while (graph != nullptr) {
-			Statistics::reset();
-			if (printBaseGraphs) {
-				graph->print();
-			}
-			Solver<VType, unsigned int>* solver = nullptr;
-			/* These check for wrong results. If a solver produces more than one
-			 * maximum matching for isomorphisms of a graph, it is noted and
-			 * printed to std::cerr. */
-			int matchingSize = -1, secondMatching = -1;
-			bool error = false;
-			int lSeed = job.seed;
-			for (unsigned int i = 0; i < job.iterations; i++) {
-				/* If the graph should be shuffled, shuffle the base graph.
-				 * By shuffling the base graph and not the implementation specific graphs,
-				 * comparability is guaranteed between different algorithms. */
-				if (job.shuffle) {
-					DEBUG("Shuffling with seed " << lSeed << "\n");
-					std::mt19937_64 g(lSeed);
-					graph->shuffle(g);
-					if (printBaseGraphs) {
-						graph->print();
-					}
-				}
-				Statistics::startMeasure();
-				VType::resetIds();
-				solver = new SType(job.solverArg1,job.solverArg2);
-				solver->readGraph(graph);
-				DEBUG("Pre calculation\n");
-				/* Time is measured after reading the graph, since building
-				 * the data structures is not part of the algorithms.
-				 * Besides it would add a hefty bias to the boost implementation,
-				 * since it is extremely slow in creating graphs. */
-				Statistics::startTimer();
-				try {
-					solver->calculateMaxMatching();
-				} catch (const std::exception & ex) {
-					std::cerr << "Crashed! Reason: " << ex.what() << "\n"; std::flush(std::cout);
-					exit(3);
-				} catch (const std::string & ex) {
-					std::cerr << "Crashed! Reason: " << ex << "\n"; std::flush(std::cout);
-					exit(2);
-				} catch (...) {
-					std::cerr << "Crashed! Reason: ???\n"; std::flush(std::cout);
-					exit(1);
-				}
-				auto reps = solver->getMatchingRepresentatives();
-				/* Stop the timer after a list containing the matching edges representatives
-				 * (ends of a matching edge) are obtained, since this is the result of the algorithms. */
-				Statistics::pauseTimer();
-				int matching = reps->size();
-				delete(reps);
-				DEBUG("Post calculation\n");
-				/* Make sure the algorithm worked correctly */
-				if (matchingSize < 0) {
-					matchingSize = matching;
-				} else if (matchingSize != matching) {
-					error = true;
-					secondMatching = matching;
+		/* The captured mates are written to the matching file, so they are verified as well */
+		if (captureMates) {
+			std::vector<std::pair<unsigned int, unsigned int>> mateLabels;
+			for (unsigned int k = 0; k < mates.size(); k++) {
+				if (mates[k] != NoMate && k < mates[k]) {
+					mateLabels.emplace_back(graph->vertexLabel[graph->order[k]], graph->vertexLabel[graph->order[mates[k]]]);
 				}
-				/* Clean up. Using fresh solvers and vertices every iterations
-				 * prevents the algorithms from cheating and reusing some information. */
-				solver->clearVertices();
-				delete(solver);
-				/* Stop the current measure, thus creating an entry for the statistics. */
-				Statistics::stopMeasure();
-				lSeed++;
 			}
-			/* Error handling */
-			if (error) {
-				std::cerr << "Found computation error! Computed both max matchings " << matchingSize << " and " << secondMatching << "!\n";
+			if (!MatchingVerifier<unsigned int>::verify(graph, mateLabels, error)) {
+				std::cerr << "Invalid mates! Reason: " << error << "\n";
+				return IterationInvalidMatching;
 			}
-			/* Print the results of the benchmark to the csv ofstream. */
-			csv << job.createCsvData() << ", "
-				<< graph->getVertexCount() << ", "
-				<< graph->getEdgeCount() << ", "
-				<< Statistics::createCsvData() << ", "
-				<< matchingSize << "\n";
-			std::flush(csv);
-			delete(graph);
-			graph = job.getSource().getNext();
 		}
 	}
+	return IterationOk;
 }
 
+/* Runs a single iteration in a child process. The measurement is added to the
+ * statistics of this process. Returns an empty string on success, otherwise
+ * the reason of the failure as it is written to the csv file. */
 template<typename SType, typename VType>
-void performJob(Job& job) {
-	performJob<SType, VType>(job, false);
+std::string runIsolatedIteration(Job& job, SimpleGraph<unsigned int>* graph, int& matching) {
+	std::flush(csv);
+	Trace::flush();
+	int code;
+	std::string output;
+	IsolationResult result = Isolation::run([&job, graph](std::string& out) {
+		int childMatching = -1;
+		IterationStatus status;
+		try {
+			status = runIteration<SType, VType>(job, graph, childMatching);
+		} catch (const std::bad_alloc & ex) {
+			status = IterationOutOfMemory;
+		}
+		if (status == IterationOk) {
+			unsigned int nMates = mates.size();
+			out.append(reinterpret_cast<const char*>(&childMatching), sizeof(childMatching));
+			out.append(reinterpret_cast<const char*>(&nMates), sizeof(nMates));
+			out.append(reinterpret_cast<const char*>(mates.data()), nMates * sizeof(unsigned int));
+			out.append(Statistics::serializeCurrent());
+		}
+		Trace::close();
+		return static_cast<int>(status);
+	}, code, output);
+	if (result == IsolationTimeout) {
+		return "TIMEOUT";
+	} else if (result == IsolationSignaled) {
+		/* SIGKILL is sent by the out of memory killer of the kernel */
+		return code == SIGKILL ? "OOM" : "CRASH";
+	} else if (code == IterationOutOfMemory) {
+		return "OOM";
+	} else if (code == IterationInvalidMatching) {
+		return "INVALID";
+	}
+	/* The output holds the matching size, the mate array and the measurement */
+	unsigned int nMates = 0;
+	if (code == IterationOk && output.size() >= sizeof(matching) + sizeof(nMates)) {
+		std::memcpy(&nMates, output.data() + sizeof(matching), sizeof(nMates));
+	}
+	size_t offset = sizeof(matching) + sizeof(nMates) + nMates * sizeof(unsigned int);
+	if (code != IterationOk || output.size() < offset
+		|| !Statistics::addSerialized(output.substr(offset))) {
+		return "CRASH";
+	}
+	std::memcpy(&matching, output.data(), sizeof(matching));
+	mates.resize(nMates);
+	std::memcpy(mates.data(), output.data() + sizeof(matching) + sizeof(nMates), nMates * sizeof(unsigned int));
+	return "";
+}
+
+/* Runs a single iteration or restores it from the ledger. Records the result
+ * in the ledger and starts a trace run if enabled. Returns an empty string on
+ * success, otherwise the reason of the failure as for runIsolatedIteration. */
+template<typename SType, typename VType>
+std::string performIteration(Job& job, SimpleGraph<unsigned int>* graph, unsigned int iteration, unsigned long seed, int& matching) {
+	/* Iterations finished by an earlier run are taken from the ledger */
+	unsigned long long key = 0;
+	if (Ledger::isEnabled()) {
+		key = Ledger::makeKey(job.getSource().printSource(), job.getSolverName(), job.solverArg1, job.solverArg2, job.seed, job.shuffle, iteration);
+		const LedgerEntry* entry = Ledger::find(key);
+		if (entry != nullptr && !entry->failure.empty()) {
+			return entry->failure;
+		} else if (entry != nullptr && Statistics::addSerialized(entry->measurement)) {
+			matching = entry->matching;
+			return "";
+		}
+	}
+	if (Trace::isEnabled()) {
+		Trace::startRun(job.getSource().printSource(), job.getSolverName(), job.solverArg1, job.solverArg2, seed, iteration);
+	}
+	std::string failure;
+	if (Isolation::isEnabled()) {
+		failure = runIsolatedIteration<SType, VType>(job, graph, matching);
+	} else {
+		IterationStatus status = runIteration<SType, VType>(job, graph, matching);
+		if (status == IterationInvalidMatching) {
+			failure = "INVALID";
+		} else if (status != IterationOk) {
+			exit(status);
+		}
+	}
+	if (Ledger::isEnabled()) {
+		if (failure.empty()) {
+			Ledger::addResult(key, matching, Statistics::serializeCurrent());
+		} else {
+			Ledger::addFailure(key, failure);
+		}
+	}
+	return failure;
 }
 
 GraphSource* makeFilesystemGraphSource(const std::string& input, const unsigned int& nNeighbors) {
@@ -192,60 +287,107 @@ GraphSource* makeFilesystemGraphSource(const std::string& input, const unsigned
 
 #define MAIN_MAKE_RANDOM_1_ARG_SOURCE(SUFFIX) \
 /**/GraphSource* makeRandom##SUFFIX##GraphSource(const unsigned int& nVertices, Job& job) { \
-/**/	std::stringstream tmpFile, output; \
-/**/	tmpFile << "assets/tmp/rnd/" << #SUFFIX << "_" << nVertices <<"_" << job.seed << ".g"; \
+/**/	std::stringstream parameters, output; \
+/**/	parameters << #SUFFIX << "_" << nVertices <<"_" << job.seed; \
 /**/	output << "\"Random "<<#SUFFIX<<" (nVertices=" << nVertices << ")\""; \
 /**/	auto gen = [&nVertices, &job](GGenerator gen) -> SimpleGraph<unsigned int>* { \
-/**/		auto rgen = Random::makeRandom(job.seed); \
-/**/		return gen.createRandom##SUFFIX(nVertices, *rgen); \
+/**/		return gen.createRandom##SUFFIX(nVertices, job.seed); \
 /**/	}; \
-/**/	return new GeneratorGraphSource(tmpFile.str(), output.str(), gen); \
+/**/	return new GeneratorGraphSource(InstanceStore::makeKey(Random##SUFFIX, parameters.str()), output.str(), gen); \
 /**/}
 #define MAIN_MAKE_RANDOM_2_ARG_SOURCE(SUFFIX) \
 /**/GraphSource* makeRandom##SUFFIX##GraphSource(const unsigned int& nVertices, const unsigned int& nNeighbors, Job& job) { \
-/**/	std::stringstream tmpFile, output; \
-/**/	tmpFile << "assets/tmp/rnd/" << #SUFFIX << "_" << nVertices <<"_" << nNeighbors <<"_" << job.seed << ".g"; \
+/**/	std::stringstream parameters, output; \
+/**/	parameters << #SUFFIX << "_" << nVertices <<"_" << nNeighbors <<"_" << job.seed; \
 /**/	output << "\"Random "<<#SUFFIX<<" (nVertices=" << nVertices << ", nNeighbors=" << nNeighbors << ")\""; \
 /**/	auto gen = [&nVertices, &nNeighbors, &job](GGenerator gen) -> SimpleGraph<unsigned int>* { \
-/**/		auto rgen = Random::makeRandom(job.seed); \
-/**/		return gen.createRandom##SUFFIX(nVertices, nNeighbors, *rgen); \
+/**/		return gen.createRandom##SUFFIX(nVertices, nNeighbors, job.seed); \
 /**/	}; \
-/**/	return new GeneratorGraphSource(tmpFile.str(), output.str(), gen); \
+/**/	return new GeneratorGraphSource(InstanceStore::makeKey(Random##SUFFIX, parameters.str()), output.str(), gen); \
 /**/}
 #define MAIN_MAKE_RANDOM_EUCLID_SOURCE(DIM) \
 /**/MAIN_MAKE_RANDOM_2_ARG_SOURCE(Euclid ## DIM ## d)
 MAIN_MAKE_RANDOM_2_ARG_SOURCE(Boost);
 MAIN_MAKE_RANDOM_2_ARG_SOURCE(Dimacs);
-#ifdef HAS_FADE
 MAIN_MAKE_RANDOM_1_ARG_SOURCE(Triangle);
-#endif
 MAIN_MAKE_RANDOM_EUCLID_SOURCE(2);
 MAIN_MAKE_RANDOM_EUCLID_SOURCE(3);
 MAIN_MAKE_RANDOM_EUCLID_SOURCE(10);
 MAIN_MAKE_RANDOM_EUCLID_SOURCE(20);
+MAIN_MAKE_RANDOM_2_ARG_SOURCE(BarabasiAlbert);
+MAIN_MAKE_RANDOM_2_ARG_SOURCE(Regular);
 #undef MAIN_MAKE_RANDOM_1_ARG_SOURCE
 #undef MAIN_MAKE_RANDOM_2_ARG_SOURCE
 #undef MAIN_MAKE_RANDOM_EUCLID_SOURCE
 
+/* The initiator probabilities are part of the key, since they change the graph */
+GraphSource* makeRandomRMatGraphSource(const unsigned int& nVertices, const unsigned int& nNeighbors, Job& job) {
+	std::stringstream parameters, output;
+	parameters << "RMat_" << nVertices << "_" << nNeighbors << "_" << rmatA << "_" << rmatB << "_" << rmatC << "_" << job.seed;
+	output << "\"Random RMat (nVertices=" << nVertices << ", nNeighbors=" << nNeighbors << ", a=" << rmatA << ", b=" << rmatB << ", c=" << rmatC << ")\"";
+	auto gen = [&nVertices, &nNeighbors, &job](GGenerator gen) -> SimpleGraph<unsigned int>* {
+		return gen.createRandomRMat(nVertices, nNeighbors, rmatA / 100.0, rmatB / 100.0, rmatC / 100.0, job.seed);
+	};
+	return new GeneratorGraphSource(InstanceStore::makeKey(RandomRMat, parameters.str()), output.str(), gen);
+}
+
+#define MAIN_MAKE_RANDOM_GRID_SOURCE(DIM) \
+/**/GraphSource* makeRandomGrid##DIM##dGraphSource(const unsigned int& width, const unsigned int& deleted, Job& job) { \
+/**/	if (GGenerator::getGridVertexCount(DIM, width) > GGenerator::MAX_VERTICES) { \
+/**/		std::cerr << "Grid" << DIM << "d of width " << width << " exceeds " << GGenerator::MAX_VERTICES << " vertices\n"; \
+/**/		return new VoidGraphSource(); \
+/**/	} \
+/**/	std::stringstream parameters, output; \
+/**/	parameters << "Grid" << DIM << "d_" << width << "_" << deleted << "_" << job.seed; \
+/**/	output << "\"Random Grid" << DIM << "d (width=" << width << ", deleted=" << deleted << "%)\""; \
+/**/	auto gen = [&width, &deleted, &job](GGenerator gen) -> SimpleGraph<unsigned int>* { \
+/**/		return gen.createRandomGrid##DIM##d(width, deleted, job.seed); \
+/**/	}; \
+/**/	return new GeneratorGraphSource(InstanceStore::makeKey(RandomGrid##DIM##d, parameters.str()), output.str(), gen); \
+/**/}
+MAIN_MAKE_RANDOM_GRID_SOURCE(2);
+MAIN_MAKE_RANDOM_GRID_SOURCE(3);
+#undef MAIN_MAKE_RANDOM_GRID_SOURCE
+
 GraphSource* makeWorstCaseGabowGraphSource(const unsigned int& m) {
-	std::stringstream tmpFile, output;
-	tmpFile << "assets/tmp/gabow/" << m << ".g";
+	std::stringstream parameters, output;
+	parameters << "WorstCaseGabow_" << m;
 	output << "\"Worst Case Gabow (m=" << m << ")\"";
 	auto gen = [&m](GGenerator gen) -> SimpleGraph<unsigned int> * {
 		return gen.createWorstCaseGabow(m);
 	};
-	return new GeneratorGraphSource(tmpFile.str(), output.str(), gen);
+	return new GeneratorGraphSource(InstanceStore::makeKey(WorstCaseGabow, parameters.str()), output.str(), gen);
+}
+
+GraphSource* makeNestedBlossomsGraphSource(const unsigned int& depth, const unsigned int& branching, Job& job) {
+	std::stringstream parameters, output;
+	parameters << "NestedBlossoms_" << depth << "_" << branching << "_" << job.seed;
+	output << "\"Nested Blossoms (depth=" << depth << ", branching=" << branching << ")\"";
+	auto gen = [&depth, &branching, &job](GGenerator gen) -> SimpleGraph<unsigned int>* {
+		return gen.createNestedBlossoms(depth, branching, job.seed);
+	};
+	return new GeneratorGraphSource(InstanceStore::makeKey(NestedBlossoms, parameters.str()), output.str(), gen);
+}
+
+GraphSource* makeBlossomChainGraphSource(const unsigned int& nBlossoms, const unsigned int& depth) {
+	std::stringstream parameters, output;
+	parameters << "BlossomChain_" << nBlossoms << "_" << depth;
+	output << "\"Blossom Chain (nBlossoms=" << nBlossoms << ", depth=" << depth << ")\"";
+	auto gen = [&nBlossoms, &depth](GGenerator gen) -> SimpleGraph<unsigned int>* {
+		return gen.createBlossomChain(nBlossoms, depth);
+	};
+	return new GeneratorGraphSource(InstanceStore::makeKey(BlossomChain, parameters.str()), output.str(), gen);
 }
 
 #define MAIN_MAKE_TS_SOURCE(SUFFIX) \
 /**/GraphSource* makeTriangleSeries##SUFFIX##GraphSource(const unsigned int& nTriangles) { \
-/**/	std::stringstream tmpFile, output; \
-/**/	tmpFile << "assets/tmp/triangles/"<<#SUFFIX<<"_" << nTriangles << ".g"; \
+/**/	std::stringstream parameters, output; \
+/**/	parameters << "TriangleSeries" << #SUFFIX << "_" << nTriangles; \
 /**/	output << "\"Triangle series "<<#SUFFIX<<" (nTriangles=" << nTriangles << ")\""; \
 /**/	auto gen = [&nTriangles](GGenerator gen) -> SimpleGraph<unsigned int>* { \
 /**/		return gen.createTriangles##SUFFIX(nTriangles); \
 /**/	}; \
-/**/	return new GeneratorGraphSource(tmpFile.str(), output.str(), gen); \
+/**/	return new GeneratorGraphSource(InstanceStore::makeKey(TriangleSeries##SUFFIX, parameters.str()), output.str(), gen); \
 /**/}
 
 MAIN_MAKE_TS_SOURCE(A)
@@ -254,13 +396,13 @@ MAIN_MAKE_TS_SOURCE(B)
 
 #define MAIN_MAKE_HC_SOURCE(SUFFIX) \
 /**/GraphSource* makeHoneyCombs##SUFFIX##GraphSource(const unsigned int& width, const unsigned int& rows) { \
-/**/	std::stringstream tmpFile, output; \
-/**/	tmpFile << "assets/tmp/honey_combs/"<<#SUFFIX<<"_" << width << "x" << rows << ".g"; \
+/**/	std::stringstream parameters, output; \
+/**/	parameters << "HoneyCombs" << #SUFFIX << "_" << width << "x" << rows; \
 /**/	output << "\"Honey Combs "<<#SUFFIX<<" (width=" << width << ", rows=" << rows << ")\""; \
 /**/	auto gen = [&width, &rows](GGenerator gen) -> SimpleGraph<unsigned int>* { \
 /**/		return gen.createHoneyCombs##SUFFIX(width, rows); \
 /**/	}; \
-/**/	return new GeneratorGraphSource(tmpFile.str(), output.str(), gen); \
+/**/	return new GeneratorGraphSource(InstanceStore::makeKey(HoneyCombs##SUFFIX, parameters.str()), output.str(), gen); \
 /**/}
 
 MAIN_MAKE_HC_SOURCE()
@@ -269,20 +411,381 @@ MAIN_MAKE_HC_SOURCE(Caps)
 MAIN_MAKE_HC_SOURCE(Inner)
 #undef MAIN_MAKE_HC_SOURCE
 
+/* Creates the graph source selected by the user. The parameters are copied,
+ * since the generator lambdas keep references to them. */
+GraphSource* makeGraphSource(SourceType src, const std::string& file, unsigned int param1, unsigned int param2, Job& job) {
+	/* In theory creating new ints here is a memory leak,
+	 * but it's happing on a way too small scale to be relevant */
+	switch (src) {
+#define MAIN_SRC_CASE_1_ARG(CASE, ARG) \
+/**/	case CASE: \
+/**/		return make##CASE##GraphSource(ARG);
+#define MAIN_SRC_CASE_2_ARG(CASE, ARG1, ARG2) \
+/**/	case CASE: \
+/**/		return make##CASE##GraphSource(ARG1, ARG2);
+#define MAIN_SRC_CASE_3_ARG(CASE, ARG1, ARG2, ARG3) \
+/**/	case CASE: \
+/**/		return make##CASE##GraphSource(ARG1, ARG2, ARG3);
+#define MAIN_SRC_CASE_1_INT_ARG(CASE) MAIN_SRC_CASE_1_ARG(CASE, *new unsigned int(param1))
+#define MAIN_SRC_CASE_2_INT_ARG(CASE) MAIN_SRC_CASE_2_ARG(CASE, *new unsigned int(param1), *new unsigned int(param2))
+#define MAIN_SRC_CASE_HC(SUFFIX) MAIN_SRC_CASE_2_INT_ARG(HoneyCombs##SUFFIX)
+		MAIN_SRC_CASE_2_ARG(Filesystem, "assets/" + file, *new unsigned int(param1));
+		MAIN_SRC_CASE_3_ARG(RandomBoost, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_3_ARG(RandomDimacs, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_2_ARG(RandomTriangle, *new unsigned int(param1), job);
+		MAIN_SRC_CASE_3_ARG(RandomEuclid2d, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_3_ARG(RandomEuclid3d, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_3_ARG(RandomEuclid10d, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_3_ARG(RandomEuclid20d, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_3_ARG(RandomRMat, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_3_ARG(RandomBarabasiAlbert, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_3_ARG(RandomRegular, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_3_ARG(RandomGrid2d, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_3_ARG(RandomGrid3d, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_1_INT_ARG(WorstCaseGabow);
+		MAIN_SRC_CASE_3_ARG(NestedBlossoms, *new unsigned int(param1), *new unsigned int(param2), job);
+		MAIN_SRC_CASE_2_INT_ARG(BlossomChain);
+		MAIN_SRC_CASE_1_INT_ARG(TriangleSeriesA);
+		MAIN_SRC_CASE_1_INT_ARG(TriangleSeriesB);
+		MAIN_SRC_CASE_HC();
+		MAIN_SRC_CASE_HC(Plus);
+		MAIN_SRC_CASE_HC(Caps);
+		MAIN_SRC_CASE_HC(Inner);
+#undef MAIN_SRC_CASE_1_ARG
+#undef MAIN_SRC_CASE_2_ARG
+#undef MAIN_SRC_CASE_3_ARG
+#undef MAIN_SRC_CASE_1_INT_ARG
+#undef MAIN_SRC_CASE_2_INT_ARG
+#undef MAIN_SRC_CASE_HC
+	}
+	return new VoidGraphSource();
+}
+
+/* Registers the benchmark loop of every solver */
+void registerSolvers() {
+#define MAIN_REGISTER_SOLVER(TYPE, SOLVER_T, VERTEX_T) \
+/**/	SolverRegistry::add(TYPE, performIteration<SOLVER_T<unsigned int>, VERTEX_T<unsigned int>>);
+	MAIN_REGISTER_SOLVER(MultiTrees, MultiTreeSolver, Vertex);
+	MAIN_REGISTER_SOLVER(MetaGraphs, norm::MetaGraphsSolver, norm::MVertex);
+	MAIN_REGISTER_SOLVER(MetaGraphsWR, wr::MetaGraphsSolver, wr::MVertex);
+	MAIN_REGISTER_SOLVER(MetaGraphsQPT, qpt::MetaGraphsSolver, qpt::MVertex);
+	MAIN_REGISTER_SOLVER(EdmondsBoost, EdmondsBoostSolver, EdmondsVertex);
+#ifdef HAS_LEMON
+	MAIN_REGISTER_SOLVER(EdmondsLemon, EdmondsLemonSolver, EdmondsVertex);
+#endif
+#ifdef HAS_BLOSSOM_IV
+	MAIN_REGISTER_SOLVER(BlossomIV, BlossomIVSolver, BlossomVertex);
+#endif
+#ifdef HAS_BLOSSOM_V
+	MAIN_REGISTER_SOLVER(BlossomV, BlossomVSolver, BlossomVertex);
+#endif
+#undef MAIN_REGISTER_SOLVER
+}
+
+/* Selects the solver in the job and runs an iteration with it, see performIteration */
+std::string performSolverIteration(Job& job, const SolverConfig& config, SimpleGraph<unsigned int>* graph, unsigned int iteration, unsigned long seed, int& matching) {
+	job.selectSolver(config);
+	const SolverRunner* runner = SolverRegistry::find(config.type);
+	if (runner == nullptr) {
+		return "CRASH";
+	}
+	return (*runner)(job, graph, iteration, seed, matching);
+}
+
+/* Writes the matching of the last iteration, if it is the first one captured for the graph.
+ * The solvers number the vertices in the shuffled order, the written mates are translated
+ * back to the indices of the graph, so the output does not depend on the shuffle. */
+void writeMatching(Job& job, SimpleGraph<unsigned int>* graph) {
+	if (captureMates && mates.size() == graph->getVertexCount()) {
+		const std::vector<unsigned int>& order = graph->order;
+		std::vector<unsigned int> indexMates(mates.size());
+		for (unsigned int k = 0; k < mates.size(); k++) {
+			indexMates[order[k]] = mates[k] == NoMate ? NoMate : order[mates[k]];
+		}
+		MatchingWriter::write(job.getSource().printSource(), graph->vertexLabel, indexMates);
+		captureMates = false;
+	}
+}
+
+/* Order in which the solvers run in an iteration. It is random, so no solver
+ * constantly profits from caches warmed up (or suffers from memory fragmented)
+ * by the solver before it. The last stream of the seed is used, which is never
+ * used by shuffling the graph. */
+std::vector<unsigned int> makeSolverOrder(unsigned int nSolvers, unsigned long seed) {
+	RandomStream g(seed, ~0ul);
+	std::vector<unsigned int> order(nSolvers);
+	for (unsigned int s = 0; s < nSolvers; s++) {
+		order[s] = s;
+	}
+	std::shuffle(order.begin(), order.end(), g);
+	return order;
+}
+
+/* Executes a job specified by the user input. If it is a compound job,
+ * every job is executed one after another. Every graph is fed to all solvers
+ * of the job before it is freed. All data is printed to the csv ofstream,
+ * one row per graph and solver. */
+void performJob(Job& job, bool isSub) {
+	/* The first call will print a header row for the csv data */
+	if (!isSub) {
+		csv << job.createCsvHeader() << ", "
+			<< "#Vertices, "
+			<< "#Edges, "
+			<< Statistics::createCsvHeader() << ", "
+			<< "Matching\n";
+	}
+	/* Compound jobs get split up. */
+	if (job.isCompound()) {
+		Job* subJob = job.nextSubJob();
+		while (subJob != nullptr) {
+			performJob(*subJob, true);
+			delete(subJob);
+			subJob = job.nextSubJob();
+		}
+	} else {
+		unsigned int nSolvers = job.solvers.size();
+		/* Iterate over all graphs provided by the source */
+		auto graph = job.getSource().getNext();
+		while (graph != nullptr) {
+			if (printBaseGraphs) {
+				graph->print();
+			}
+			/* Measurements of every solver, they are aggregated after all iterations */
+			std::vector<std::vector<std::string>> measurements(nSolvers);
+			/* These check for wrong results. If a solver produces more than one
+			 * maximum matching for isomorphisms of a graph, it is noted and
+			 * printed to std::cerr. */
+			std::vector<int> matchingSizes(nSolvers, -1);
+			/* Reason, why an isolated iteration of a solver failed */
+			std::vector<std::string> failures(nSolvers);
+			/* Only the first matching computed for the graph is written */
+			captureMates = MatchingWriter::isEnabled();
+			int lSeed = job.seed;
+			for (unsigned int i = 0; i < job.iterations; i++) {
+				/* If the graph should be shuffled, shuffle the base graph.
+				 * By shuffling the base graph and not the implementation specific graphs,
+				 * comparability is guaranteed between different algorithms. */
+				if (job.shuffle) {
+					DEBUG("Shuffling with seed " << lSeed << "\n");
+					graph->shuffle(lSeed);
+					if (printBaseGraphs) {
+						graph->print();
+					}
+				}
+				for (unsigned int s : makeSolverOrder(nSolvers, lSeed)) {
+					if (!failures[s].empty()) {
+						continue;
+					}
+					Statistics::reset();
+					int matching = -1;
+					mates.clear();
+					failures[s] = performSolverIteration(job, job.solvers[s], graph, i, lSeed, matching);
+					if (!failures[s].empty()) {
+						std::cerr << "Iteration " << i << " of " << job.getSolverName() << " on " << job.getSource().printSource() << " failed: " << failures[s] << "\n";
+						continue;
+					}
+					writeMatching(job, graph);
+					measurements[s].push_back(Statistics::serializeCurrent());
+					/* Make sure the algorithm worked correctly */
+					if (matchingSizes[s] < 0) {
+						matchingSizes[s] = matching;
+					} else if (matchingSizes[s] != matching) {
+						std::cerr << "Found computation error! " << job.getSolverName() << " computed both max matchings " << matchingSizes[s] << " and " << matching << "!\n";
+					}
+				}
+				lSeed++;
+			}
+			/* Print the results of the benchmark to the csv ofstream. */
+			int matchingSize = -1;
+			for (unsigned int s = 0; s < nSolvers; s++) {
+				job.selectSolver(job.solvers[s]);
+				csv << job.createCsvData() << ", "
+					<< graph->getVertexCount() << ", "
+					<< graph->getEdgeCount() << ", ";
+				if (failures[s].empty()) {
+					Statistics::reset();
+					for (const std::string& measurement : measurements[s]) {
+						Statistics::addSerialized(measurement);
+					}
+					csv << Statistics::createCsvData() << ", "
+						<< matchingSizes[s] << "\n";
+					/* All solvers have to find a maximum matching of the same size */
+					if (matchingSize < 0) {
+						matchingSize = matchingSizes[s];
+					} else if (matchingSize != matchingSizes[s]) {
+						std::cerr << "Found computation error! " << job.getSolverName() << " computed max matching " << matchingSizes[s] << " instead of " << matchingSize << "!\n";
+					}
+				} else {
+					csv << Statistics::createEmptyCsvData() << ", "
+						<< failures[s] << "\n";
+				}
+			}
+			std::flush(csv);
+			delete(graph);
+			graph = job.getSource().getNext();
+		}
+	}
+}
+
+void performJob(Job& job) {
+	performJob(job, false);
+}
+
+/* Benchmarks all solvers of the suite on the graphs of a job. Every graph is loaded
+ * once and shuffled once per iteration, then all solvers run on the same permutation.
+ * Each iteration of each solver is printed as one row of a long format table. */
+void performSuiteJob(Job& job, std::ostream& out) {
+	if (job.isCompound()) {
+		Job* subJob = job.nextSubJob();
+		while (subJob != nullptr) {
+			performSuiteJob(*subJob, out);
+			delete(subJob);
+			subJob = job.nextSubJob();
+		}
+		return;
+	}
+	unsigned int nSolvers = job.solvers.size();
+	auto graph = job.getSource().getNext();
+	while (graph != nullptr) {
+		/* A solver failing an iteration is skipped for the remaining iterations of the graph */
+		std::vector<bool> failed(nSolvers, false);
+		int matchingSize = -1;
+		captureMates = MatchingWriter::isEnabled();
+		unsigned long lSeed = job.seed;
+		for (unsigned int i = 0; i < job.iterations; i++) {
+			if (job.shuffle) {
+				DEBUG("Shuffling with seed " << lSeed << "\n");
+				graph->shuffle(lSeed);
+			}
+			for (unsigned int s : makeSolverOrder(nSolvers, lSeed)) {
+				if (failed[s]) {
+					continue;
+				}
+				Statistics::reset();
+				int matching = -1;
+				mates.clear();
+				std::string failure = performSolverIteration(job, job.solvers[s], graph, i, lSeed, matching);
+				out << job.createCsvData() << ", "
+					<< i << ", "
+					<< graph->getVertexCount() << ", "
+					<< graph->getEdgeCount() << ", ";
+				if (failure.empty()) {
+					writeMatching(job, graph);
+					out << Statistics::createCurrentCsvData() << ", "
+						<< matching << "\n";
+					/* All solvers have to find a maximum matching of the same size */
+					if (matchingSize < 0) {
+						matchingSize = matching;
+					} else if (matchingSize != matching) {
+						std::cerr << "Found computation error! " << job.getSolverName() << " computed max matching " << matching << " instead of " << matchingSize << "!\n";
+					}
+				} else {
+					failed[s] = true;
+					out << Statistics::createEmptyCurrentCsvData() << ", "
+						<< failure << "\n";
+					std::cerr << "Iteration " << i << " of " << job.getSolverName() << " on " << job.getSource().printSource() << " failed: " << failure << "\n";
+				}
+			}
+			std::flush(out);
+			lSeed++;
+		}
+		delete(graph);
+		graph = job.getSource().getNext();
+	}
+}
+
+/* Executes a benchmark suite and writes the long format table to its output file */
+void performSuite(Suite& suite) {
+	std::ofstream out(suite.output);
+	/* Owns the seed the random sources refer to */
+	Job base;
+	base.seed = suite.seed;
+	out << base.createCsvHeader() << ", "
+		<< "Iteration, "
+		<< "#Vertices, "
+		<< "#Edges, "
+		<< Statistics::createCurrentCsvHeader() << ", "
+		<< "Matching\n";
+	for (SuiteSource& source : suite.sources) {
+		for (unsigned int param1 : source.param1) {
+			for (unsigned int param2 : source.param2) {
+				Job job;
+				job.seed = suite.seed;
+				job.shuffle = suite.shuffle;
+				job.iterations = suite.iterations;
+				job.solvers = suite.solvers;
+				job.setSource(makeGraphSource(source.type, source.file, param1, param2, base));
+				performSuiteJob(job, out);
+			}
+		}
+	}
+	out.close();
+}
+
 int main(int argc, char** argv) {
 	/* Init job */
 	JobCollection job;
 	job.shuffle = false;
 	job.seed = maxmatching::Time::currentTimeMillis();
-	job.solver = MultiTrees;
 
 	SourceType src = SourceType::RandomBoost;
-	std::string file;
-	IntStepper iterationsStepper, param1Stepper, param2Stepper, algParam1Stepper, algParam2Stepper;
+	std::string file, suiteFile;
+	IntStepper iterationsStepper, param1Stepper, param2Stepper;
+	SolverType solver;
+	unsigned int nArgs;
+	registerSolvers();
 	/* Options */
 	for (int i = 1; i < argc; i += 1) {
 		if (std::strcmp(argv[i], "-o") == 0) {
 			printBaseGraphs = true;
+		} else if (std::strcmp(argv[i], "-pc") == 0) {
+			PerfCounters::setEnabled(true);
+		} else if (std::strcmp(argv[i], "-mem") == 0) {
+			MemoryTracker::setEnabled(true);
+		} else if (std::strcmp(argv[i], "-v") == 0) {
+			verifyMatchings = true;
+		} else if (std::strcmp(argv[i], "-t") == 0) {
+			Trace::open("trace.jsonl");
+		} else if (std::strcmp(argv[i], "-suite") == 0) {
+			suiteFile = argv[i + 1];
+			i++;
+		} else if (std::strcmp(argv[i], "-m") == 0) {
+			MatchingWriter::open(argv[i + 1], true);
+			i++;
+		} else if (std::strcmp(argv[i], "-mp") == 0) {
+			MatchingWriter::open(argv[i + 1], false);
+			i++;
+		} else if (std::strcmp(argv[i], "-l") == 0) {
+			Ledger::open(argv[i + 1]);
+			i++;
+		} else if (std::strcmp(argv[i], "-store") == 0) {
+			storeCapacity = std::atol(argv[i + 1]);
+			i++;
+		} else if (std::strcmp(argv[i], "-iso") == 0) {
+			Isolation::setEnabled(std::atoi(argv[i + 1]), std::atol(argv[i + 2]));
+			i += 2;
+		} else if (std::strcmp(argv[i], "-ev") == 0) {
+			if (!EventTrace::setEnabled(argv[i + 1])) {
+				std::cerr << "Unknown event category in " << argv[i + 1] << "\n";
+				return 1;
+			}
+			long capacity = std::atol(argv[i + 2]);
+			if (capacity <= 0 || static_cast<unsigned long>(capacity) > EventTrace::MAX_CAPACITY) {
+				std::cerr << "Invalid event trace capacity " << argv[i + 2] << ", allowed are 1 to " << EventTrace::MAX_CAPACITY << "\n";
+				return 1;
+			}
+			EventTrace::setCapacity(capacity);
+			EventTrace::installCrashHandler();
+			i += 2;
+		} else if (std::strcmp(argv[i], "-rmat") == 0) {
+			rmatA = std::atoi(argv[i + 1]);
+			rmatB = std::atoi(argv[i + 2]);
+			rmatC = std::atoi(argv[i + 3]);
+			if (rmatA + rmatB + rmatC > 100 || rmatB + rmatC == 0) {
+				std::cerr << "Invalid R-MAT probabilities " << rmatA << ", " << rmatB << ", " << rmatC << "\n";
+				return 1;
+			}
+			i += 3;
 		} else if (std::strcmp(argv[i], "-i") == 0) {
 			iterationsStepper = Strings::parseIntStepper(argv[i + 1]);
 			i++;
@@ -296,162 +799,56 @@ int main(int argc, char** argv) {
 			job.shuffle = false;
 			job.seed = std::atol(argv[i + 1]);
 			i++;
-		} else if (std::strcmp(argv[i], "-f") == 0) {
-			file = argv[i + 1];
-			i++;
-			param1Stepper = Strings::parseIntStepper(argv[i + 1]);
-			i++;
-			param2Stepper = IntStepper();
-			src = Filesystem;
+		} else if (Job::findSourceFlag(argv[i], src, nArgs)) {
+			if (src == Filesystem) {
+				file = argv[i + 1];
+				param1Stepper = Strings::parseIntStepper(argv[i + 2]);
+				param2Stepper = IntStepper();
+			} else {
+				param1Stepper = Strings::parseIntStepper(argv[i + 1]);
+				param2Stepper = nArgs > 1 ? Strings::parseIntStepper(argv[i + 2]) : IntStepper();
+			}
+			i += nArgs;
+		} else if (Job::findSolverFlag(argv[i], solver, nArgs)) {
+			/* Multiple solvers are benchmarked on the same graphs */
+			Job::expandSolver(solver,
+				nArgs > 0 ? Strings::parseIntStepper(argv[i + 1]) : IntStepper(),
+				nArgs > 1 ? Strings::parseIntStepper(argv[i + 2]) : IntStepper(),
+				job.solvers);
+			i += nArgs;
 		}
-#define MAIN_READ_SRC_1_ARG(FLAG, CASE) \
-/**/	else if(std::strcmp(argv[i], FLAG) == 0) { \
-/**/		param1Stepper = Strings::parseIntStepper(argv[i + 1]); \
-/**/		i++; \
-/**/		param2Stepper = IntStepper(); \
-/**/		src = CASE; \
-/**/	}
-#define MAIN_READ_SRC_2_ARG(FLAG, CASE) \
-/**/	else if(std::strcmp(argv[i], FLAG) == 0) { \
-/**/		param1Stepper = Strings::parseIntStepper(argv[i + 1]); \
-/**/		i++; \
-/**/		param2Stepper = Strings::parseIntStepper(argv[i + 1]); \
-/**/		i++; \
-/**/		src = CASE; \
-/**/	}
-		MAIN_READ_SRC_2_ARG("-Gr", RandomBoost)
-			MAIN_READ_SRC_2_ARG("-Grd", RandomDimacs)
-#ifdef HAS_FADE
-			MAIN_READ_SRC_1_ARG("-Grt", RandomTriangle)
-#endif
-			MAIN_READ_SRC_2_ARG("-Gre2", RandomEuclid2d)
-			MAIN_READ_SRC_2_ARG("-Gre3", RandomEuclid3d)
-			MAIN_READ_SRC_2_ARG("-Gre10", RandomEuclid10d)
-			MAIN_READ_SRC_2_ARG("-Gre20", RandomEuclid20d)
-			MAIN_READ_SRC_1_ARG("-Gg", WorstCaseGabow)
-			MAIN_READ_SRC_1_ARG("-Gta", TriangleSeriesA)
-			MAIN_READ_SRC_1_ARG("-Gtb", TriangleSeriesB)
-			MAIN_READ_SRC_2_ARG("-Ghc", HoneyCombs)
-			MAIN_READ_SRC_2_ARG("-Ghcp", HoneyCombsPlus)
-			MAIN_READ_SRC_2_ARG("-Ghcc", HoneyCombsCaps)
-			MAIN_READ_SRC_2_ARG("-Ghci", HoneyCombsInner)
-#undef MAIN_READ_SRC_1_ARG
-#undef MAIN_READ_SRC_2_ARG
-#define MAIN_READ_SOLVER(FLAG, CASE) \
-/**/	else if(std::strcmp(argv[i], FLAG) == 0) { \
-/**/		job.solver = CASE; \
-/**/		algParam1Stepper = IntStepper(); \
-/**/		algParam2Stepper = IntStepper(); \
-/**/	}
-#define MAIN_READ_SOLVER_1_ARG(FLAG, CASE) \
-/**/	else if(std::strcmp(argv[i], FLAG) == 0) { \
-/**/		job.solver = CASE; \
-/**/		algParam1Stepper = Strings::parseIntStepper(argv[i + 1]); \
-/**/		algParam2Stepper = IntStepper(); \
-/**/		i++; \
-/**/	}
-#define MAIN_READ_SOLVER_2_ARG(FLAG, CASE) \
-/**/	else if(std::strcmp(argv[i], FLAG) == 0) { \
-/**/		job.solver = CASE; \
-/**/		algParam1Stepper = Strings::parseIntStepper(argv[i + 1]); \
-/**/		algParam2Stepper = Strings::parseIntStepper(argv[i + 2]); \
-/**/		i+=2; \
-/**/	}
-			MAIN_READ_SOLVER("-mt", MultiTrees)
-			MAIN_READ_SOLVER("-mg", MetaGraphs)
-			MAIN_READ_SOLVER_1_ARG("-mgwr", MetaGraphsWR)
-			MAIN_READ_SOLVER_2_ARG("-mgqpt", MetaGraphsQPT)
-			MAIN_READ_SOLVER("-eb", EdmondsBoost)
-#ifdef HAS_LEMON
-			MAIN_READ_SOLVER("-el", EdmondsLemon)
-#endif
-#ifdef HAS_BLOSSOM_IV
-			MAIN_READ_SOLVER_1_ARG("-biv", BlossomIV)
-#endif
-#ifdef HAS_BLOSSOM_V
-			MAIN_READ_SOLVER_1_ARG("-bv", BlossomV)
-#endif
-#undef MAIN_READ_SOLVER
 	}
-	for (int iterations : iterationsStepper) {
-		JobCollection* iterSubJob = new JobCollection();
-		job.addJob(iterSubJob);
-		iterSubJob->iterations = iterations;
-		for (int param1 : param1Stepper) {
-			for (int param2 : param2Stepper) {
-				for (int algParam1 : algParam1Stepper) {
-					for (int algParam2 : algParam2Stepper) {
-						Job* subJob = new Job();
-						iterSubJob->addJob(subJob);
-						subJob->solverArg1 = algParam1;
-						subJob->solverArg2 = algParam2;
-						/* In theory creating new ints here is a memory leak,
-						 * but it's happing on a way too small scale to be relevant */
-						switch (src) {
-#define MAIN_SRC_CASE_1_ARG(CASE, ARG) \
-/**/					case CASE: \
-/**/						subJob->setSource(make##CASE##GraphSource(ARG)); \
-/**/						break;
-#define MAIN_SRC_CASE_2_ARG(CASE, ARG1, ARG2) \
-/**/					case CASE: \
-/**/						subJob->setSource(make##CASE##GraphSource(ARG1, ARG2)); \
-/**/						break;
-#define MAIN_SRC_CASE_3_ARG(CASE, ARG1, ARG2, ARG3) \
-/**/					case CASE: \
-/**/						subJob->setSource(make##CASE##GraphSource(ARG1, ARG2, ARG3)); \
-/**/						break;
-#define MAIN_SRC_CASE_1_INT_ARG(CASE) MAIN_SRC_CASE_1_ARG(CASE, *new unsigned int(param1))
-#define MAIN_SRC_CASE_2_INT_ARG(CASE) MAIN_SRC_CASE_2_ARG(CASE, *new unsigned int(param1), *new unsigned int(param2))
-#define MAIN_SRC_CASE_HC(SUFFIX) MAIN_SRC_CASE_2_INT_ARG(HoneyCombs##SUFFIX)
-							MAIN_SRC_CASE_2_ARG(Filesystem, "assets/" + file, *new unsigned int(param1));
-							MAIN_SRC_CASE_3_ARG(RandomBoost, *new unsigned int(param1), *new unsigned int(param2), job);
-							MAIN_SRC_CASE_3_ARG(RandomDimacs, *new unsigned int(param1), *new unsigned int(param2), job);
-#ifdef HAS_FADE
-							MAIN_SRC_CASE_2_ARG(RandomTriangle, *new unsigned int(param1), job);
-#endif
-							MAIN_SRC_CASE_3_ARG(RandomEuclid2d, *new unsigned int(param1), *new unsigned int(param2), job);
-							MAIN_SRC_CASE_3_ARG(RandomEuclid3d, *new unsigned int(param1), *new unsigned int(param2), job);
-							MAIN_SRC_CASE_3_ARG(RandomEuclid10d, *new unsigned int(param1), *new unsigned int(param2), job);
-							MAIN_SRC_CASE_3_ARG(RandomEuclid20d, *new unsigned int(param1), *new unsigned int(param2), job);
-							MAIN_SRC_CASE_1_INT_ARG(WorstCaseGabow);
-							MAIN_SRC_CASE_1_INT_ARG(TriangleSeriesA);
-							MAIN_SRC_CASE_1_INT_ARG(TriangleSeriesB);
-							MAIN_SRC_CASE_HC();
-							MAIN_SRC_CASE_HC(Plus);
-							MAIN_SRC_CASE_HC(Caps);
-							MAIN_SRC_CASE_HC(Inner);
-#undef MAIN_SRC_CASE_1_ARG
-#undef MAIN_SRC_CASE_3_ARG
-#undef MAIN_SRC_CASE_1_INT_ARG
-#undef MAIN_SRC_CASE_2_INT_ARG
-#undef MAIN_SRC_CASE_HC
-						}
-					}
+	InstanceStore::open(storeCapacity << 20);
+	if (!suiteFile.empty()) {
+		Suite suite;
+		std::string error;
+		if (!suite.load(suiteFile, error)) {
+			std::cerr << "Invalid suite " << suiteFile << ": " << error << "\n";
+			return 1;
+		}
+		performSuite(suite);
+	} else {
+		if (job.solvers.empty()) {
+			job.solvers.push_back({ MultiTrees, 0, 0 });
+		}
+		for (int iterations : iterationsStepper) {
+			JobCollection* iterSubJob = new JobCollection();
+			job.addJob(iterSubJob);
+			iterSubJob->iterations = iterations;
+			for (int param1 : param1Stepper) {
+				for (int param2 : param2Stepper) {
+					Job* subJob = new Job();
+					iterSubJob->addJob(subJob);
+					subJob->setSource(makeGraphSource(src, file, param1, param2, job));
 				}
 			}
 		}
-	}
-	switch (job.solver) {
-#define MAIN_MAKE_SOLVER_CASE(TYPE, SOLVER_T, VERTEX_T, JOB) \
-/**/	case TYPE: \
-/**/		performJob<SOLVER_T<unsigned int>, VERTEX_T<unsigned int>>(JOB); \
-/**/		break;
-		MAIN_MAKE_SOLVER_CASE(MultiTrees, MultiTreeSolver, Vertex, job);
-		MAIN_MAKE_SOLVER_CASE(MetaGraphs, norm::MetaGraphsSolver, norm::MVertex, job);
-		MAIN_MAKE_SOLVER_CASE(MetaGraphsWR, wr::MetaGraphsSolver, wr::MVertex, job);
-		MAIN_MAKE_SOLVER_CASE(MetaGraphsQPT, qpt::MetaGraphsSolver, qpt::MVertex, job);
-		MAIN_MAKE_SOLVER_CASE(EdmondsBoost, EdmondsBoostSolver, EdmondsVertex, job);
-#ifdef HAS_LEMON
-		MAIN_MAKE_SOLVER_CASE(EdmondsLemon, EdmondsLemonSolver, EdmondsVertex, job);
-#endif
-#ifdef HAS_BLOSSOM_IV
-		MAIN_MAKE_SOLVER_CASE(BlossomIV, BlossomIVSolver, BlossomVertex, job);
-#endif
-#ifdef HAS_BLOSSOM_V
-		MAIN_MAKE_SOLVER_CASE(BlossomV, BlossomVSolver, BlossomVertex, job);
-#endif
-#undef MAIN_MAKE_SOLVER_CASE
+		performJob(job);
 	}
 	csv.close();
+	Trace::close();
+	Ledger::close();
+	MatchingWriter::close();
+	PerfCounters::close();
 	std::exit(0);
 }
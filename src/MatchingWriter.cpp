@@ -0,0 +1,68 @@
+#include "MatchingWriter.h"
+#include "Solver.h"
+
+namespace maxmatching {
+	std::ofstream* MatchingWriter::out = nullptr;
+	bool MatchingWriter::binary = true;
+
+	MatchingWriter::MatchingWriter() {}
+	MatchingWriter::~MatchingWriter() {}
+
+	void MatchingWriter::open(const std::string& file, bool binary) {
+		MatchingWriter::close();
+		MatchingWriter::binary = binary;
+		if (binary) {
+			MatchingWriter::out = new std::ofstream(file, std::ios::binary);
+			*MatchingWriter::out << "MMAT";
+			MatchingWriter::writeInt(1);
+		} else {
+			MatchingWriter::out = new std::ofstream(file);
+		}
+	}
+
+	void MatchingWriter::close() {
+		if (MatchingWriter::out != nullptr) {
+			MatchingWriter::out->close();
+			delete(MatchingWriter::out);
+			MatchingWriter::out = nullptr;
+		}
+	}
+
+	bool MatchingWriter::isEnabled() {
+		return MatchingWriter::out != nullptr;
+	}
+
+	void MatchingWriter::writeInt(unsigned int value) {
+		MatchingWriter::out->write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	void MatchingWriter::write(const std::string& instance, const std::vector<unsigned int>& labels, const std::vector<unsigned int>& mates) {
+		if (MatchingWriter::out == nullptr) {
+			return;
+		}
+		unsigned int n = mates.size();
+		if (MatchingWriter::binary) {
+			bool identity = true;
+			for (unsigned int k = 0; k < n && identity; k++) {
+				identity = labels[k] == k;
+			}
+			MatchingWriter::writeInt(instance.size());
+			MatchingWriter::out->write(instance.data(), instance.size());
+			MatchingWriter::writeInt(n);
+			MatchingWriter::writeInt(identity ? 0 : 1);
+			if (!identity) {
+				MatchingWriter::out->write(reinterpret_cast<const char*>(labels.data()), n * sizeof(unsigned int));
+			}
+			MatchingWriter::out->write(reinterpret_cast<const char*>(mates.data()), n * sizeof(unsigned int));
+		} else {
+			*MatchingWriter::out << "# " << instance << "\n";
+			for (unsigned int k = 0; k < n; k++) {
+				if (mates[k] != NoMate && k < mates[k]) {
+					*MatchingWriter::out << labels[k] << " " << labels[mates[k]] << "\n";
+				}
+			}
+			*MatchingWriter::out << "\n";
+		}
+		MatchingWriter::out->flush();
+	}
+}
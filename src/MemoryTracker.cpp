@@ -0,0 +1,145 @@
+#include "MemoryTracker.h"
+#include <new>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#ifdef __GLIBC__
+#include <malloc.h>
+#define MEMORY_TRACKER_BLOCK_SIZE(PTR) malloc_usable_size(PTR)
+#else
+#define MEMORY_TRACKER_BLOCK_SIZE(PTR) 0
+#endif
+
+namespace maxmatching {
+	std::atomic<bool> MemoryTracker::enabled(false);
+	std::atomic<unsigned long> MemoryTracker::nAllocations(0);
+	std::atomic<unsigned long> MemoryTracker::allocatedBytes(0);
+	std::atomic<long> MemoryTracker::liveBytes(0);
+	std::atomic<long> MemoryTracker::peakLiveBytes(0);
+	long MemoryTracker::baseLiveBytes = 0;
+
+	MemoryTracker::MemoryTracker() {}
+	MemoryTracker::~MemoryTracker() {}
+
+	void MemoryTracker::setEnabled(bool enabled) {
+		MemoryTracker::enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool MemoryTracker::isEnabled() {
+		return MemoryTracker::enabled.load(std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::recordAllocation(void* ptr) {
+		if (!MemoryTracker::enabled.load(std::memory_order_relaxed)) {
+			return;
+		}
+		long size = MEMORY_TRACKER_BLOCK_SIZE(ptr);
+		MemoryTracker::nAllocations.fetch_add(1, std::memory_order_relaxed);
+		MemoryTracker::allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		long live = MemoryTracker::liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+		long peak = MemoryTracker::peakLiveBytes.load(std::memory_order_relaxed);
+		while (live > peak && !MemoryTracker::peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+	}
+
+	void MemoryTracker::recordDeallocation(void* ptr) {
+		if (ptr == nullptr || !MemoryTracker::enabled.load(std::memory_order_relaxed)) {
+			return;
+		}
+		/* Blocks allocated before tracking started may make this negative,
+		 * which is fine since only differences are reported */
+		MemoryTracker::liveBytes.fetch_sub(MEMORY_TRACKER_BLOCK_SIZE(ptr), std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::startRun() {
+		MemoryTracker::nAllocations.store(0, std::memory_order_relaxed);
+		MemoryTracker::allocatedBytes.store(0, std::memory_order_relaxed);
+		MemoryTracker::baseLiveBytes = MemoryTracker::liveBytes.load(std::memory_order_relaxed);
+		MemoryTracker::peakLiveBytes.store(MemoryTracker::baseLiveBytes, std::memory_order_relaxed);
+		/* Resets the VmHWM of the process on Linux, silently fails elsewhere */
+		std::ofstream clearRefs("/proc/self/clear_refs");
+		if (clearRefs) {
+			clearRefs << "5";
+		}
+	}
+
+	unsigned long MemoryTracker::getPeakHeapBytes() {
+		long peak = MemoryTracker::peakLiveBytes.load(std::memory_order_relaxed) - MemoryTracker::baseLiveBytes;
+		return peak > 0 ? peak : 0;
+	}
+
+	unsigned long MemoryTracker::getAllocatedBytes() {
+		return MemoryTracker::allocatedBytes.load(std::memory_order_relaxed);
+	}
+
+	unsigned long MemoryTracker::getAllocations() {
+		return MemoryTracker::nAllocations.load(std::memory_order_relaxed);
+	}
+
+	unsigned long MemoryTracker::getPeakResidentBytes() {
+		std::ifstream status("/proc/self/status");
+		std::string token;
+		while (status >> token) {
+			if (token == "VmHWM:") {
+				unsigned long kiloBytes = 0;
+				status >> kiloBytes;
+				return kiloBytes * 1024;
+			}
+		}
+		return 0;
+	}
+}
+
+/* Replacements of the global allocation functions. All other variants
+ * (arrays, nothrow, sized delete) forward to these by default, the aligned
+ * variants forward to the aligned replacements below. */
+void* operator new(std::size_t size) {
+	void* ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	maxmatching::MemoryTracker::recordAllocation(ptr);
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+	maxmatching::MemoryTracker::recordDeallocation(ptr);
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t size) noexcept {
+	(void)size;
+	maxmatching::MemoryTracker::recordDeallocation(ptr);
+	std::free(ptr);
+}
+
+#ifdef __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	std::size_t align = static_cast<std::size_t>(alignment);
+	if (align < sizeof(void*)) {
+		align = sizeof(void*);
+	}
+	/* aligned_alloc requires the size to be a multiple of the alignment */
+	std::size_t padded = (size == 0 ? 1 : size) + align - 1;
+	void* ptr = std::aligned_alloc(align, padded - padded % align);
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	maxmatching::MemoryTracker::recordAllocation(ptr);
+	return ptr;
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+	(void)alignment;
+	maxmatching::MemoryTracker::recordDeallocation(ptr);
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t size, std::align_val_t alignment) noexcept {
+	(void)size;
+	(void)alignment;
+	maxmatching::MemoryTracker::recordDeallocation(ptr);
+	std::free(ptr);
+}
+#endif
+
+#undef MEMORY_TRACKER_BLOCK_SIZE
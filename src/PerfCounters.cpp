@@ -0,0 +1,123 @@
+#include "PerfCounters.h"
+#include <iostream>
+#ifdef __linux__
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+namespace maxmatching {
+	bool PerfCounters::enabled = false;
+	bool PerfCounters::initialized = false;
+	int PerfCounters::leaderFd = -1;
+	int PerfCounters::fds[PerfEventCount] = { -1, -1, -1, -1 };
+	int PerfCounters::groupIndex[PerfEventCount] = { -1, -1, -1, -1 };
+	unsigned int PerfCounters::nOpened = 0;
+
+	PerfCounters::PerfCounters() {}
+	PerfCounters::~PerfCounters() {}
+
+	void PerfCounters::setEnabled(bool enabled) {
+		PerfCounters::enabled = enabled;
+	}
+
+	bool PerfCounters::isEnabled() {
+		return PerfCounters::enabled;
+	}
+
+	bool PerfCounters::isAvailable(PerfEvent event) {
+		return PerfCounters::groupIndex[event] >= 0;
+	}
+
+	/* Opens the counters lazily on first use */
+	void PerfCounters::init() {
+		PerfCounters::initialized = true;
+#ifdef __linux__
+		const unsigned long long configs[PerfEventCount] = {
+			PERF_COUNT_HW_CPU_CYCLES,
+			PERF_COUNT_HW_INSTRUCTIONS,
+			PERF_COUNT_HW_CACHE_MISSES,
+			PERF_COUNT_HW_BRANCH_MISSES
+		};
+		for (unsigned int i = 0; i < PerfEventCount; i++) {
+			struct perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = configs[i];
+			attr.disabled = (PerfCounters::leaderFd < 0) ? 1 : 0;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP;
+			int fd = syscall(__NR_perf_event_open, &attr, 0, -1, PerfCounters::leaderFd, 0);
+			if (fd < 0) {
+				continue;
+			}
+			if (PerfCounters::leaderFd < 0) {
+				PerfCounters::leaderFd = fd;
+			}
+			PerfCounters::fds[i] = fd;
+			PerfCounters::groupIndex[i] = PerfCounters::nOpened++;
+		}
+#endif
+		if (PerfCounters::nOpened < PerfEventCount) {
+			std::cerr << "Warning: Only " << PerfCounters::nOpened << " of " << PerfEventCount
+				<< " hardware performance counters are available. Missing counters are reported as 0.\n";
+		}
+	}
+
+	void PerfCounters::start() {
+		if (!PerfCounters::enabled) {
+			return;
+		}
+		if (!PerfCounters::initialized) {
+			PerfCounters::init();
+		}
+#ifdef __linux__
+		if (PerfCounters::leaderFd >= 0) {
+			ioctl(PerfCounters::leaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl(PerfCounters::leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		}
+#endif
+	}
+
+	void PerfCounters::stop(unsigned long* values) {
+		if (!PerfCounters::enabled || PerfCounters::leaderFd < 0) {
+			return;
+		}
+#ifdef __linux__
+		ioctl(PerfCounters::leaderFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		/* Group read format: number of events followed by their values */
+		std::vector<unsigned long long> buffer(PerfEventCount + 1, 0);
+		ssize_t n = read(PerfCounters::leaderFd, buffer.data(), buffer.size() * sizeof(unsigned long long));
+		if (n < (ssize_t)sizeof(unsigned long long)) {
+			return;
+		}
+		for (unsigned int i = 0; i < PerfEventCount; i++) {
+			int idx = PerfCounters::groupIndex[i];
+			if (idx >= 0 && (unsigned long long)idx < buffer[0]) {
+				values[i] += buffer[idx + 1];
+			}
+		}
+#else
+		(void)values;
+#endif
+	}
+
+	void PerfCounters::close() {
+#ifdef __linux__
+		for (unsigned int i = 0; i < PerfEventCount; i++) {
+			if (PerfCounters::fds[i] >= 0) {
+				::close(PerfCounters::fds[i]);
+				PerfCounters::fds[i] = -1;
+			}
+			PerfCounters::groupIndex[i] = -1;
+		}
+#endif
+		PerfCounters::leaderFd = -1;
+		PerfCounters::nOpened = 0;
+		PerfCounters::initialized = false;
+	}
+}
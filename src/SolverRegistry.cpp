@@ -0,0 +1,20 @@
+#include "SolverRegistry.h"
+
+namespace maxmatching {
+	std::map<SolverType, SolverRunner> SolverRegistry::runners;
+
+	SolverRegistry::SolverRegistry() {}
+	SolverRegistry::~SolverRegistry() {}
+
+	void SolverRegistry::add(SolverType type, const SolverRunner& runner) {
+		SolverRegistry::runners[type] = runner;
+	}
+
+	const SolverRunner* SolverRegistry::find(SolverType type) {
+		auto it = SolverRegistry::runners.find(type);
+		if (it == SolverRegistry::runners.end()) {
+			return nullptr;
+		}
+		return &it->second;
+	}
+}
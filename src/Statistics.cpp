@@ -1,4 +1,5 @@
 #include "Statistics.h"
+#include <cstring>
 
 #define M_ULONG_MAX std::numeric_limits<long>::max()
 #define M_INFINITY std::numeric_limits<double>::infinity()
@@ -58,6 +59,18 @@
 	M_SORT_ALL(FIELD ## Created)\
 	M_SORT_ALL(FIELD ## Deleted)\
 
+#define M_SERIALIZE(FIELD)\
+	ret.append(reinterpret_cast<const char*>(&Statistics::cur ## FIELD), sizeof(Statistics::cur ## FIELD));
+#define M_SERIALIZE_CD(FIELD)\
+	M_SERIALIZE(FIELD ## Created)\
+	M_SERIALIZE(FIELD ## Deleted)
+#define M_DESERIALIZE(FIELD)\
+	std::memcpy(&Statistics::cur ## FIELD, data.data() + pos, sizeof(Statistics::cur ## FIELD));\
+	pos += sizeof(Statistics::cur ## FIELD);
+#define M_DESERIALIZE_CD(FIELD)\
+	M_DESERIALIZE(FIELD ## Created)\
+	M_DESERIALIZE(FIELD ## Deleted)
+
 #define M_PRINT(STREAM, FIELD, UNIT)\
 	STREAM << #FIELD << " min:\t" << Statistics::getMin ## FIELD() << " " << UNIT << "\n";\
 	STREAM << #FIELD << " max:\t" << Statistics::getMax ## FIELD() << " " << UNIT << "\n";\
@@ -74,12 +87,26 @@ namespace maxmatching {
 	bool Statistics::timerRunning = false;
 	unsigned long Statistics::startStamp = 0;
 
+	std::vector<unsigned long> Statistics::allPhase[PhaseCount];
+	unsigned long Statistics::totPhase[PhaseCount] = {};
+	unsigned long Statistics::curPhase[PhaseCount] = {};
+	unsigned long Statistics::phaseStamp[PhaseCount] = {};
+	unsigned int Statistics::phaseNesting[PhaseCount] = {};
+
 	M_INIT_CD(unsigned long, Vert);
 	M_INIT_CD(unsigned long, Edge);
 	M_INIT_CD(unsigned long, Tree);
 	M_INIT_CD(unsigned long, Blos);
 	M_INIT(unsigned long, MComp);
 	M_INIT(unsigned long, Time);
+	M_INIT(unsigned long, Cycles);
+	M_INIT(unsigned long, Instructions);
+	M_INIT(unsigned long, CacheMisses);
+	M_INIT(unsigned long, BranchMisses);
+	M_INIT(unsigned long, PeakHeap);
+	M_INIT(unsigned long, AllocBytes);
+	M_INIT(unsigned long, Allocs);
+	M_INIT(unsigned long, PeakRss);
 	M_INIT(double, I);
 	M_INIT(double, RI);
 
@@ -94,8 +121,20 @@ namespace maxmatching {
 		M_PROCESS_FIELD_CD(Blos);
 		M_PROCESS_FIELD(MComp);
 		M_PROCESS_FIELD(Time);
+		M_PROCESS_FIELD(Cycles);
+		M_PROCESS_FIELD(Instructions);
+		M_PROCESS_FIELD(CacheMisses);
+		M_PROCESS_FIELD(BranchMisses);
+		M_PROCESS_FIELD(PeakHeap);
+		M_PROCESS_FIELD(AllocBytes);
+		M_PROCESS_FIELD(Allocs);
+		M_PROCESS_FIELD(PeakRss);
 		M_PROCESS_FIELD(I);
 		M_PROCESS_FIELD(RI);
+		for (unsigned int p = 0; p < PhaseCount; p++) {
+			Statistics::allPhase[p].push_back(Statistics::curPhase[p]);
+			Statistics::totPhase[p] += Statistics::curPhase[p];
+		}
 	}
 
 	void Statistics::reset() {
@@ -110,9 +149,22 @@ namespace maxmatching {
 		M_RESET_CD(Blos);
 		M_RESET(MComp);
 		M_RESET(Time);
+		M_RESET(Cycles);
+		M_RESET(Instructions);
+		M_RESET(CacheMisses);
+		M_RESET(BranchMisses);
+		M_RESET(PeakHeap);
+		M_RESET(AllocBytes);
+		M_RESET(Allocs);
+		M_RESET(PeakRss);
 
 		M_RESET(I);
 		M_RESET(RI);
+		for (unsigned int p = 0; p < PhaseCount; p++) {
+			Statistics::allPhase[p].clear();
+			Statistics::allPhase[p].shrink_to_fit();
+			Statistics::totPhase[p] = 0;
+		}
 	}
 
 	void Statistics::resetCurrent() {
@@ -122,8 +174,20 @@ namespace maxmatching {
 		M_RESET_CUR_CD(Blos);
 		M_RESET_CUR(MComp);
 		M_RESET_CUR(Time);
+		M_RESET_CUR(Cycles);
+		M_RESET_CUR(Instructions);
+		M_RESET_CUR(CacheMisses);
+		M_RESET_CUR(BranchMisses);
+		M_RESET_CUR(PeakHeap);
+		M_RESET_CUR(AllocBytes);
+		M_RESET_CUR(Allocs);
+		M_RESET_CUR(PeakRss);
 		M_RESET_CUR(I);
 		M_RESET_CUR(RI);
+		for (unsigned int p = 0; p < PhaseCount; p++) {
+			Statistics::curPhase[p] = 0;
+			Statistics::phaseNesting[p] = 0;
+		}
 	}
 
 	void Statistics::startMeasure() {
@@ -132,6 +196,9 @@ namespace maxmatching {
 				Statistics::paused = false;
 			} else {
 				Statistics::resetCurrent();
+				if (MemoryTracker::isEnabled()) {
+					MemoryTracker::startRun();
+				}
 			}
 			Statistics::processing = true;
 		}
@@ -154,25 +221,93 @@ namespace maxmatching {
 			if (Statistics::timerRunning) {
 				Statistics::pauseTimer();
 			}
+			if (MemoryTracker::isEnabled()) {
+				Statistics::curPeakHeap = MemoryTracker::getPeakHeapBytes();
+				Statistics::curAllocBytes = MemoryTracker::getAllocatedBytes();
+				Statistics::curAllocs = MemoryTracker::getAllocations();
+				Statistics::curPeakRss = MemoryTracker::getPeakResidentBytes();
+			}
 			Statistics::processCurrent();
 		}
 	}
 
 	void Statistics::startTimer() {
 		Statistics::timerRunning = true;
-		Statistics::startStamp = Time::currentTimeMillis();
+		PerfCounters::start();
+		Statistics::startStamp = Time::currentTimeNanos();
 	}
 
 	void Statistics::pauseTimer() {
 		if (Statistics::timerRunning) {
-			Statistics::curTime += Time::currentTimeMillis() - Statistics::startStamp;
+			Statistics::curTime += Time::currentTimeNanos() - Statistics::startStamp;
+			unsigned long counters[PerfEventCount] = {};
+			PerfCounters::stop(counters);
+			Statistics::curCycles += counters[PerfCycles];
+			Statistics::curInstructions += counters[PerfInstructions];
+			Statistics::curCacheMisses += counters[PerfCacheMisses];
+			Statistics::curBranchMisses += counters[PerfBranchMisses];
 			Statistics::timerRunning = false;
 		}
 	}
 
+	/* Phases may be nested into themselves (e.g. deep meta solvers sharing the
+	 * last depth column), in which case only the outermost call is timed. */
+	void Statistics::startPhase(StatisticsPhase phase) {
+		if (Statistics::phaseNesting[phase]++ == 0) {
+			Statistics::phaseStamp[phase] = Time::currentTimeNanos();
+		}
+	}
+
+	void Statistics::stopPhase(StatisticsPhase phase) {
+		if (Statistics::phaseNesting[phase] > 0 && --Statistics::phaseNesting[phase] == 0) {
+			Statistics::curPhase[phase] += Time::currentTimeNanos() - Statistics::phaseStamp[phase];
+		}
+	}
+
+	/* The top level solver has depth 0, thus meta solvers start at depth 1 */
+	StatisticsPhase Statistics::getMetaSolvePhase(unsigned int depth) {
+		if (depth < 1) {
+			depth = 1;
+		} else if (depth > STATISTICS_META_DEPTHS) {
+			depth = STATISTICS_META_DEPTHS;
+		}
+		return static_cast<StatisticsPhase>(PhaseMetaSolve + depth - 1);
+	}
+
+	std::string Statistics::getPhaseName(unsigned int phase) {
+		std::stringstream ret;
+		switch (phase) {
+			case PhaseReadGraph: ret << "Read graph"; break;
+			case PhasePreSort: ret << "Pre sort"; break;
+			case PhaseGreedy: ret << "Greedy"; break;
+			case PhaseGrow: ret << "Grow"; break;
+			case PhaseShrink: ret << "Blossom shrink"; break;
+			case PhaseApply: ret << "Apply meta matching"; break;
+			default:
+				ret << "Meta solve depth " << (phase - PhaseMetaSolve + 1);
+				if (phase == PhaseCount - 1) {
+					ret << "+";
+				}
+				break;
+		}
+		return ret.str();
+	}
+
 	std::string Statistics::createReport() {
 		std::stringstream ret;
-		M_PRINT(ret, Time, "ms");
+		M_PRINT(ret, Time, "ns");
+		if (PerfCounters::isEnabled()) {
+			M_PRINT(ret, Cycles, "");
+			M_PRINT(ret, Instructions, "");
+			M_PRINT(ret, CacheMisses, "");
+			M_PRINT(ret, BranchMisses, "");
+		}
+		if (MemoryTracker::isEnabled()) {
+			M_PRINT(ret, PeakHeap, "B");
+			M_PRINT(ret, AllocBytes, "B");
+			M_PRINT(ret, Allocs, "");
+			M_PRINT(ret, PeakRss, "B");
+		}
 		M_PRINT_CD(ret, Vert, "");
 		M_PRINT_CD(ret, Edge, "");
 		M_PRINT_CD(ret, Tree, "");
@@ -180,6 +315,12 @@ namespace maxmatching {
 		M_PRINT(ret, MComp, "");
 		M_PRINT(ret, I, "");
 		M_PRINT(ret, RI, "");
+		for (unsigned int p = 0; p < PhaseCount; p++) {
+			StatisticsPhase phase = static_cast<StatisticsPhase>(p);
+			ret << Statistics::getPhaseName(p) << " min:\t" << Statistics::getMinPhase(phase) << " ns\n";
+			ret << Statistics::getPhaseName(p) << " max:\t" << Statistics::getMaxPhase(phase) << " ns\n";
+			ret << Statistics::getPhaseName(p) << " avg:\t" << Statistics::getAveragePhase(phase) << " ns\n";
+		}
 		return ret.str();
 	}
 
@@ -201,8 +342,19 @@ namespace maxmatching {
 		M_SORT_ALL_CD(Blos);
 		M_SORT_ALL(MComp);
 		M_SORT_ALL(Time);
+		M_SORT_ALL(Cycles);
+		M_SORT_ALL(Instructions);
+		M_SORT_ALL(CacheMisses);
+		M_SORT_ALL(BranchMisses);
+		M_SORT_ALL(PeakHeap);
+		M_SORT_ALL(AllocBytes);
+		M_SORT_ALL(Allocs);
+		M_SORT_ALL(PeakRss);
 		M_SORT_ALL(I);
 		M_SORT_ALL(RI);
+		for (unsigned int p = 0; p < PhaseCount; p++) {
+			std::sort(Statistics::allPhase[p].begin(), Statistics::allPhase[p].end());
+		}
 	}
 
 	M_GETTER_CD(unsigned long, Vert);
@@ -211,12 +363,43 @@ namespace maxmatching {
 	M_GETTER_CD(unsigned long, Blos);
 	M_GETTER(unsigned long, MComp);
 	M_GETTER(unsigned long, Time);
+	M_GETTER(unsigned long, Cycles);
+	M_GETTER(unsigned long, Instructions);
+	M_GETTER(unsigned long, CacheMisses);
+	M_GETTER(unsigned long, BranchMisses);
+	M_GETTER(unsigned long, PeakHeap);
+	M_GETTER(unsigned long, AllocBytes);
+	M_GETTER(unsigned long, Allocs);
+	M_GETTER(unsigned long, PeakRss);
 	M_GETTER(double, I);
 	M_GETTER(double, RI);
 
 	M_SETTER(double, I);
 	M_SETTER(double, RI);
 
+	unsigned long Statistics::getMinPhase(StatisticsPhase phase) {
+		return Statistics::allPhase[phase].front();
+	}
+	unsigned long Statistics::getMaxPhase(StatisticsPhase phase) {
+		return Statistics::allPhase[phase].back();
+	}
+	unsigned long Statistics::get05PercentilePhase(StatisticsPhase phase) {
+		return Statistics::allPhase[phase][(Statistics::allPhase[phase].size() - 1) * 0.05];
+	}
+	unsigned long Statistics::get95PercentilePhase(StatisticsPhase phase) {
+		return Statistics::allPhase[phase][(Statistics::allPhase[phase].size() - 1) * 0.95];
+	}
+	unsigned long Statistics::getMedianPhase(StatisticsPhase phase) {
+		return Statistics::allPhase[phase][(Statistics::allPhase[phase].size() - 1) * 0.5];
+	}
+	double Statistics::getAveragePhase(StatisticsPhase phase) {
+		if (Statistics::nMeasurements == 0) return 0;
+		return Statistics::totPhase[phase] / double(Statistics::nMeasurements);
+	}
+	unsigned long Statistics::getCurrentPhase(StatisticsPhase phase) {
+		return Statistics::curPhase[phase];
+	}
+
 	std::string Statistics::createCsvHeader() {
 		std::stringstream ret;
 #define M_APPEND(NAME) \
@@ -228,14 +411,35 @@ namespace maxmatching {
 /**/	<< #NAME << " avg";
 #define M_APPEND_CD(NAME) \
 /**/M_APPEND(NAME created) ret << ", "; M_APPEND(NAME deleted)
-		M_APPEND(Computation time(ms)); ret << ", ";
+		M_APPEND(Computation time(ns)); ret << ", ";
+		if (PerfCounters::isEnabled()) {
+			M_APPEND(CPU cycles); ret << ", ";
+			M_APPEND(Instructions); ret << ", ";
+			M_APPEND(Cache misses); ret << ", ";
+			M_APPEND(Branch misses); ret << ", ";
+		}
 		M_APPEND_CD(Vertices); ret << ", ";
 		M_APPEND_CD(Edges); ret << ", ";
 		M_APPEND_CD(Trees); ret << ", ";
 		M_APPEND_CD(Blossoms); ret << ", ";
+		if (MemoryTracker::isEnabled()) {
+			M_APPEND(Peak heap(B)); ret << ", ";
+			M_APPEND(Allocated(B)); ret << ", ";
+			M_APPEND(Allocations); ret << ", ";
+			M_APPEND(Peak RSS(B)); ret << ", ";
+		}
 		M_APPEND(Max blossom complexity); ret << ", ";
 		M_APPEND(I); ret << ", ";
 		M_APPEND(RI);
+		for (unsigned int p = 0; p < PhaseCount; p++) {
+			std::string name = Statistics::getPhaseName(p) + " time(ns)";
+			ret << ", " << name << " min, "
+				<< name << " max, "
+				<< name << " 5-percentile, "
+				<< name << " 95-percentile, "
+				<< name << " median, "
+				<< name << " avg";
+		}
 #undef M_APPEND_CD
 #undef M_APPEND
 		return ret.str();
@@ -254,17 +458,151 @@ namespace maxmatching {
 #define M_APPEND_CD(FIELD) \
 /**/M_APPEND(FIELD ## Created) ret << ", "; M_APPEND(FIELD ## Deleted)
 		M_APPEND(Time); ret << ", ";
+		if (PerfCounters::isEnabled()) {
+			M_APPEND(Cycles); ret << ", ";
+			M_APPEND(Instructions); ret << ", ";
+			M_APPEND(CacheMisses); ret << ", ";
+			M_APPEND(BranchMisses); ret << ", ";
+		}
 		M_APPEND_CD(Vert); ret << ", ";
 		M_APPEND_CD(Edge); ret << ", ";
 		M_APPEND_CD(Tree); ret << ", ";
 		M_APPEND_CD(Blos); ret << ", ";
+		if (MemoryTracker::isEnabled()) {
+			M_APPEND(PeakHeap); ret << ", ";
+			M_APPEND(AllocBytes); ret << ", ";
+			M_APPEND(Allocs); ret << ", ";
+			M_APPEND(PeakRss); ret << ", ";
+		}
 		M_APPEND(MComp); ret << ", ";
 		M_APPEND(I); ret << ", ";
 		M_APPEND(RI);
+		for (unsigned int p = 0; p < PhaseCount; p++) {
+			StatisticsPhase phase = static_cast<StatisticsPhase>(p);
+			ret << ", " << Statistics::getMinPhase(phase) << ", "
+				<< Statistics::getMaxPhase(phase) << ", "
+				<< Statistics::get05PercentilePhase(phase) << ", "
+				<< Statistics::get95PercentilePhase(phase) << ", "
+				<< Statistics::getMedianPhase(phase) << ", "
+				<< Statistics::getAveragePhase(phase);
+		}
 #undef M_APPEND_CD
 #undef M_APPEND
 		return ret.str();
 	}
+
+	/* Creates an empty value for every column of the header */
+	std::string Statistics::createEmptyColumns(const std::string& header) {
+		std::stringstream ret;
+		for (std::string::size_type pos = header.find(", "); pos != std::string::npos; pos = header.find(", ", pos + 2)) {
+			ret << ", ";
+		}
+		return ret.str();
+	}
+
+	std::string Statistics::createEmptyCsvData() {
+		return Statistics::createEmptyColumns(Statistics::createCsvHeader());
+	}
+
+	std::string Statistics::createCurrentCsvHeader() {
+		std::stringstream ret;
+		ret << "Computation time(ns)";
+		if (PerfCounters::isEnabled()) {
+			ret << ", CPU cycles, Instructions, Cache misses, Branch misses";
+		}
+		ret << ", Vertices created, Vertices deleted"
+			<< ", Edges created, Edges deleted"
+			<< ", Trees created, Trees deleted"
+			<< ", Blossoms created, Blossoms deleted";
+		if (MemoryTracker::isEnabled()) {
+			ret << ", Peak heap(B), Allocated(B), Allocations, Peak RSS(B)";
+		}
+		ret << ", Max blossom complexity, I, RI";
+		for (unsigned int p = 0; p < PhaseCount; p++) {
+			ret << ", " << Statistics::getPhaseName(p) << " time(ns)";
+		}
+		return ret.str();
+	}
+
+	std::string Statistics::createCurrentCsvData() {
+		std::stringstream ret;
+		ret << Statistics::curTime;
+		if (PerfCounters::isEnabled()) {
+			ret << ", " << Statistics::curCycles
+				<< ", " << Statistics::curInstructions
+				<< ", " << Statistics::curCacheMisses
+				<< ", " << Statistics::curBranchMisses;
+		}
+		ret << ", " << Statistics::curVertCreated << ", " << Statistics::curVertDeleted
+			<< ", " << Statistics::curEdgeCreated << ", " << Statistics::curEdgeDeleted
+			<< ", " << Statistics::curTreeCreated << ", " << Statistics::curTreeDeleted
+			<< ", " << Statistics::curBlosCreated << ", " << Statistics::curBlosDeleted;
+		if (MemoryTracker::isEnabled()) {
+			ret << ", " << Statistics::curPeakHeap
+				<< ", " << Statistics::curAllocBytes
+				<< ", " << Statistics::curAllocs
+				<< ", " << Statistics::curPeakRss;
+		}
+		ret << ", " << Statistics::curMComp
+			<< ", " << Statistics::curI
+			<< ", " << Statistics::curRI;
+		for (unsigned int p = 0; p < PhaseCount; p++) {
+			ret << ", " << Statistics::curPhase[p];
+		}
+		return ret.str();
+	}
+
+	std::string Statistics::createEmptyCurrentCsvData() {
+		return Statistics::createEmptyColumns(Statistics::createCurrentCsvHeader());
+	}
+
+	std::string Statistics::serializeCurrent() {
+		std::string ret;
+		M_SERIALIZE_CD(Vert);
+		M_SERIALIZE_CD(Edge);
+		M_SERIALIZE_CD(Tree);
+		M_SERIALIZE_CD(Blos);
+		M_SERIALIZE(MComp);
+		M_SERIALIZE(Time);
+		M_SERIALIZE(Cycles);
+		M_SERIALIZE(Instructions);
+		M_SERIALIZE(CacheMisses);
+		M_SERIALIZE(BranchMisses);
+		M_SERIALIZE(PeakHeap);
+		M_SERIALIZE(AllocBytes);
+		M_SERIALIZE(Allocs);
+		M_SERIALIZE(PeakRss);
+		M_SERIALIZE(I);
+		M_SERIALIZE(RI);
+		ret.append(reinterpret_cast<const char*>(Statistics::curPhase), sizeof(Statistics::curPhase));
+		return ret;
+	}
+
+	bool Statistics::addSerialized(const std::string& data) {
+		if (data.size() != Statistics::serializeCurrent().size()) {
+			return false;
+		}
+		std::string::size_type pos = 0;
+		M_DESERIALIZE_CD(Vert);
+		M_DESERIALIZE_CD(Edge);
+		M_DESERIALIZE_CD(Tree);
+		M_DESERIALIZE_CD(Blos);
+		M_DESERIALIZE(MComp);
+		M_DESERIALIZE(Time);
+		M_DESERIALIZE(Cycles);
+		M_DESERIALIZE(Instructions);
+		M_DESERIALIZE(CacheMisses);
+		M_DESERIALIZE(BranchMisses);
+		M_DESERIALIZE(PeakHeap);
+		M_DESERIALIZE(AllocBytes);
+		M_DESERIALIZE(Allocs);
+		M_DESERIALIZE(PeakRss);
+		M_DESERIALIZE(I);
+		M_DESERIALIZE(RI);
+		std::memcpy(Statistics::curPhase, data.data() + pos, sizeof(Statistics::curPhase));
+		Statistics::processCurrent();
+		return true;
+	}
 }
 
 #undef M_ULONG_MAX
@@ -288,5 +626,9 @@ namespace maxmatching {
 #undef M_SETTER_CD
 #undef M_SORT_ALL
 #undef M_SORT_ALL_CD
+#undef M_SERIALIZE
+#undef M_SERIALIZE_CD
+#undef M_DESERIALIZE
+#undef M_DESERIALIZE_CD
 #undef M_PRINT
 #undef M_PRINT_CD
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "Suite.h"
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include "Tools.h"
+
+namespace maxmatching {
+	Suite::Suite()
+		: seed(Time::currentTimeMillis())
+		, shuffle(false)
+		, iterations(1)
+		, output("suite.csv")
+		, sources()
+		, solvers() {}
+
+	Suite::~Suite() {}
+
+	bool Suite::load(const std::string& file, std::string& error) {
+		using boost::property_tree::ptree;
+		ptree tree;
+		try {
+			boost::property_tree::read_json(file, tree);
+		} catch (const boost::property_tree::json_parser_error& ex) {
+			error = ex.what();
+			return false;
+		}
+		try {
+			this->seed = tree.get<unsigned long>("seed", this->seed);
+			this->shuffle = tree.get<bool>("shuffle", this->shuffle);
+			this->iterations = tree.get<unsigned int>("iterations", this->iterations);
+			this->output = tree.get<std::string>("output", this->output);
+		} catch (const boost::property_tree::ptree_error& ex) {
+			error = ex.what();
+			return false;
+		}
+		/* Arguments are given as strings, so ranges like "0:2" can be used */
+		const ptree empty;
+		auto readArgs = [&empty](const ptree& entry) {
+			std::vector<std::string> ret;
+			for (auto& arg : entry.get_child("args", empty)) {
+				ret.push_back(arg.second.get_value<std::string>());
+			}
+			return ret;
+		};
+		unsigned int nArgs;
+		for (auto& entry : tree.get_child("sources", empty)) {
+			std::string flag = entry.second.get<std::string>("source", "");
+			SuiteSource source;
+			if (!Job::findSourceFlag(flag, source.type, nArgs)) {
+				error = "Unknown source \"" + flag + "\"";
+				return false;
+			}
+			std::vector<std::string> args = readArgs(entry.second);
+			if (args.size() != nArgs) {
+				error = "Wrong number of arguments for source " + flag;
+				return false;
+			}
+			if (source.type == Filesystem) {
+				source.file = args[0];
+				source.param1 = Strings::parseIntStepper(args[1]);
+			} else {
+				source.param1 = Strings::parseIntStepper(args[0]);
+				if (nArgs > 1) {
+					source.param2 = Strings::parseIntStepper(args[1]);
+				}
+			}
+			this->sources.push_back(source);
+		}
+		for (auto& entry : tree.get_child("solvers", empty)) {
+			std::string flag = entry.second.get<std::string>("solver", "");
+			SolverType type;
+			if (!Job::findSolverFlag(flag, type, nArgs)) {
+				error = "Unknown solver \"" + flag + "\"";
+				return false;
+			}
+			std::vector<std::string> args = readArgs(entry.second);
+			if (args.size() != nArgs) {
+				error = "Wrong number of arguments for solver " + flag;
+				return false;
+			}
+			Job::expandSolver(type,
+				nArgs > 0 ? Strings::parseIntStepper(args[0]) : IntStepper(),
+				nArgs > 1 ? Strings::parseIntStepper(args[1]) : IntStepper(),
+				this->solvers);
+		}
+		if (this->sources.empty() || this->solvers.empty()) {
+			error = "A suite needs at least one source and one solver";
+			return false;
+		}
+		return true;
+	}
+}
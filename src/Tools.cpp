@@ -1,10 +1,16 @@
 #include "Tools.h"
+#include <atomic>
+#include <thread>
 
 namespace maxmatching {
 	/* Time */
 	unsigned long Time::currentTimeMillis() {
 		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 	}
+	/* Monotonic timestamp for benchmarking. Only differences are meaningful. */
+	unsigned long Time::currentTimeNanos() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
 
 	/* Strings */
 	bool Strings::startsWith(const std::string& str, const std::string& prefix) {
@@ -86,18 +92,64 @@ namespace maxmatching {
 	void Files::makePathToFile(const std::string & file) {
 		Files::makePath(file.substr(0, file.find_last_of("/\\")));
 	}
-	/* Create the name for a buffer file given the name of a tsp file. */
-	std::string Files::inputFileToBufferFile(const std::string & inputFile, const int& nNeighbors) {
-		std::cmatch cm;
-		std::regex_match(inputFile.c_str(), cm, std::regex("(.*\\/)*([^\\/\\\\]+)\\.[^\\/\\\\]+"));
-		std::string input = cm[2];
-		std::stringstream bufferFile;
-		bufferFile << "assets/tmp/tsp/" << input << "_" << nNeighbors << ".g";
-		return bufferFile.str();
+
+	/* RandomStream */
+	RandomStream::RandomStream(unsigned long seed, unsigned long stream)
+		: seed(seed)
+		, stream(stream)
+		, position(0)
+		, buffer()
+		, buffered(0) {}
+
+	/* Encrypts the counter (position, stream) with ten Philox rounds,
+	 * yielding the next two 64 bit numbers. */
+	void RandomStream::generateBlock() {
+		const unsigned int M0 = 0xD2511F53, M1 = 0xCD9E8D57, W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+		unsigned int c0 = this->position, c1 = this->position >> 32, c2 = this->stream, c3 = this->stream >> 32;
+		unsigned int k0 = this->seed, k1 = this->seed >> 32;
+		for (unsigned int round = 0; round < 10; round++) {
+			unsigned long p0 = (unsigned long)M0 * c0, p1 = (unsigned long)M1 * c2;
+			c0 = (unsigned int)(p1 >> 32) ^ c1 ^ k0;
+			c1 = (unsigned int)p1;
+			c2 = (unsigned int)(p0 >> 32) ^ c3 ^ k1;
+			c3 = (unsigned int)p0;
+			k0 += W0;
+			k1 += W1;
+		}
+		this->buffer[0] = ((unsigned long)c1 << 32) | c0;
+		this->buffer[1] = ((unsigned long)c3 << 32) | c2;
+		this->buffered = 2;
+		this->position++;
 	}
 
-	/* Random */
-	std::mt19937_64* Random::makeRandom(const long& seed) {
-		return new std::mt19937_64(seed);
+	/* Parallel */
+	unsigned int Parallel::getThreadCount() {
+		unsigned int ret = std::thread::hardware_concurrency();
+		return ret > 0 ? ret : 1;
+	}
+	/* Runs all tasks on up to one thread per core. Every thread takes the next open task,
+	 * so tasks should be independent of each other and of the order they are run in. */
+	void Parallel::forEach(unsigned long nTasks, const std::function<void(unsigned long)>& task) {
+		unsigned long nThreads = std::min<unsigned long>(Parallel::getThreadCount(), nTasks);
+		if (nThreads <= 1) {
+			for (unsigned long i = 0; i < nTasks; i++) {
+				task(i);
+			}
+			return;
+		}
+		std::atomic<unsigned long> next(0);
+		auto worker = [&next, nTasks, &task]() {
+			for (unsigned long i = next++; i < nTasks; i = next++) {
+				task(i);
+			}
+		};
+		std::vector<std::thread> threads;
+		for (unsigned long t = 1; t < nThreads; t++) {
+			threads.emplace_back(worker);
+		}
+		worker();
+		for (auto& thread : threads) {
+			thread.join();
+		}
 	}
 }
@@ -0,0 +1,106 @@
+#include "Trace.h"
+
+namespace maxmatching {
+	std::ofstream* Trace::out = nullptr;
+	unsigned long Trace::runCtr = 0;
+
+	Trace::Trace() {}
+	Trace::~Trace() {}
+
+	void Trace::open(const std::string& file) {
+		Trace::close();
+		Trace::out = new std::ofstream(file);
+		Trace::runCtr = 0;
+	}
+
+	void Trace::close() {
+		if (Trace::out != nullptr) {
+			Trace::out->close();
+			delete(Trace::out);
+			Trace::out = nullptr;
+		}
+	}
+
+	void Trace::flush() {
+		if (Trace::out != nullptr) {
+			Trace::out->flush();
+		}
+	}
+
+	bool Trace::isEnabled() {
+		return Trace::out != nullptr;
+	}
+
+	/* Writes a JSON string literal */
+	void Trace::writeString(std::ostream& stream, const std::string& str) {
+		stream << '"';
+		for (char c : str) {
+			switch (c) {
+				case '"': stream << "\\\""; break;
+				case '\\': stream << "\\\\"; break;
+				case '\n': stream << "\\n"; break;
+				case '\t': stream << "\\t"; break;
+				default: stream << c; break;
+			}
+		}
+		stream << '"';
+	}
+
+	void Trace::writeArray(std::ostream& stream, const std::vector<unsigned int>& values) {
+		stream << '[';
+		for (unsigned int i = 0; i < values.size(); i++) {
+			if (i > 0) {
+				stream << ',';
+			}
+			stream << values[i];
+		}
+		stream << ']';
+	}
+
+	void Trace::startRun(const std::string& source, const std::string& solver, unsigned int solverArg1, unsigned int solverArg2, unsigned long seed, unsigned int iteration) {
+		if (Trace::out == nullptr) {
+			return;
+		}
+		Trace::runCtr++;
+		std::ostream& stream = *Trace::out;
+		stream << "{\"type\":\"run\",\"run\":" << Trace::runCtr << ",\"source\":";
+		/* Sources are printed quoted for the CSV file */
+		if (source.size() >= 2 && source.front() == '"' && source.back() == '"') {
+			Trace::writeString(stream, source.substr(1, source.size() - 2));
+		} else {
+			Trace::writeString(stream, source);
+		}
+		stream << ",\"solver\":";
+		Trace::writeString(stream, solver);
+		stream << ",\"solverArg1\":" << solverArg1
+			<< ",\"solverArg2\":" << solverArg2
+			<< ",\"seed\":" << seed
+			<< ",\"iteration\":" << iteration
+			<< "}\n";
+	}
+
+	void Trace::writeRound(const TraceRound& round) {
+		if (Trace::out == nullptr) {
+			return;
+		}
+		std::ostream& stream = *Trace::out;
+		stream << "{\"type\":\"round\",\"run\":" << Trace::runCtr
+			<< ",\"depth\":" << round.depth
+			<< ",\"round\":" << round.round
+			<< ",\"unmatched\":" << round.nUnmatched
+			<< ",\"growTrees\":";
+		Trace::writeArray(stream, round.growTrees);
+		stream << ",\"shrinkableTrees\":";
+		Trace::writeArray(stream, round.shrinkableTrees);
+		stream << ",\"frustratedTrees\":" << round.frustratedTrees
+			<< ",\"metaVertices\":" << round.metaVertices
+			<< ",\"metaEdges\":" << round.metaEdges
+			<< ",\"metaMatching\":" << round.metaMatching
+			<< ",\"blossomsCreated\":" << round.blossomsCreated
+			<< ",\"growNs\":" << round.growNs
+			<< ",\"shrinkNs\":" << round.shrinkNs
+			<< ",\"metaSolveNs\":" << round.metaSolveNs
+			<< ",\"applyNs\":" << round.applyNs
+			<< "}\n";
+	}
+}
@@ -1,55 +1,294 @@
 #include "TriangleGenerator.h"
+#include <algorithm>
+#include "GGenerator.h"
 
 namespace maxmatching {
-	TriangleGenerator::TriangleGenerator() {}
-
+	TriangleGenerator::TriangleGenerator()
+		: stamp(0)
+		, last(0) {}
 
 	TriangleGenerator::~TriangleGenerator() {}
 
-	SimpleGraph<unsigned int>* TriangleGenerator::generate(unsigned int nPoints, std::mt19937_64& rgen) {
-		SimpleGraph<unsigned int>* ret = new SimpleGraph<unsigned int>();
-#ifdef HAS_FADE
-		yMap dummyMap;
-		unsigned int dummyIdx = 0;
-		GEOM_FADE2D::Fade_2D delaunay;
-		std::vector<GEOM_FADE2D::Point2> points;
-		xMap idxMap;
+	/* Position on a Hilbert curve through the grid of all coordinates. Points close
+	 * on the curve are close in the plane, so the walks to the next point stay short. */
+	unsigned long TriangleGenerator::hilbertKey(unsigned long x, unsigned long y) {
+		unsigned long key = 0;
+		for (unsigned long s = 1ul << (TriangleGenerator::COORD_BITS - 1); s > 0; s >>= 1) {
+			unsigned long rx = (x & s) > 0 ? 1 : 0;
+			unsigned long ry = (y & s) > 0 ? 1 : 0;
+			key += s * s * ((3 * rx) ^ ry);
+			if (ry == 0) {
+				/* Only the lower bits are used afterwards, so flipping all bits mirrors the quadrant */
+				if (rx == 1) {
+					x = ~x;
+					y = ~y;
+				}
+				std::swap(x, y);
+			}
+		}
+		return key;
+	}
+
+	long TriangleGenerator::orient(const Point& a, const Point& b, const Point& c) {
+		return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	}
+
+	/* Differences have at most COORD_BITS + 1 bits, so the products of
+	 * squared lengths and orientations fit into 128 bits */
+	bool TriangleGenerator::inCircle(const Point& a, const Point& b, const Point& c, const Point& d) {
+		long adx = a.x - d.x, ady = a.y - d.y;
+		long bdx = b.x - d.x, bdy = b.y - d.y;
+		long cdx = c.x - d.x, cdy = c.y - d.y;
+		__int128 det = (__int128)(adx * adx + ady * ady) * (bdx * cdy - cdx * bdy)
+			+ (__int128)(bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy)
+			+ (__int128)(cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+		return det > 0;
+	}
+
+	/* Draws the points from stream 0 and sorts them along the Hilbert curve. Duplicates
+	 * are adjacent after sorting and are drawn again from stream 1, which is rare enough
+	 * to simply sort again. */
+	void TriangleGenerator::drawPoints(unsigned int nPoints, unsigned long seed, std::vector<unsigned int>& order) {
+		const unsigned long mask = (1ul << TriangleGenerator::COORD_BITS) - 1;
+		RandomStream rgen(seed, 0);
+		RandomStream redraw(seed, 1);
+		auto draw = [mask](RandomStream& gen) {
+			unsigned long r = gen();
+			Point p;
+			p.x = (long)(r >> (64 - TriangleGenerator::COORD_BITS));
+			p.y = (long)(r & mask);
+			return p;
+		};
+		this->points.resize(nPoints);
+		std::vector<std::pair<unsigned long, unsigned int>> keys(nPoints);
 		for (unsigned int i = 0; i < nPoints; i++) {
-			/* Probably change the range here? */
-			GEOM_FADE2D::Point2 newP = GEOM_FADE2D::Point2(rgen(), rgen());
-			double newPx = newP.x();
-			double newPy = newP.y();
-			auto insertX = idxMap.insert(std::make_pair(newPx, yMap()));
-			auto insertY = insertX.first->second.insert(std::make_pair(newPy, i));
-			if (insertY.second == false) {
-				i--;
-			} else {
-				points.push_back(newP);
-				ret->addVertex(i);
-			}
-		}
-		delaunay.insert(points);
-		std::vector<GEOM_FADE2D::Triangle2*> trianglePointers;
-		delaunay.getTrianglePointers(trianglePointers);
-		for (GEOM_FADE2D::Triangle2* tp : trianglePointers) {
+			this->points[i] = draw(rgen);
+			keys[i] = std::make_pair(TriangleGenerator::hilbertKey(this->points[i].x, this->points[i].y), i);
+		}
+		bool duplicates = true;
+		while (duplicates) {
+			std::sort(keys.begin(), keys.end());
+			duplicates = false;
+			for (unsigned int k = 1; k < nPoints; k++) {
+				if (keys[k].first == keys[k - 1].first) {
+					unsigned int i = keys[k].second;
+					this->points[i] = draw(redraw);
+					keys[k].first = TriangleGenerator::hilbertKey(this->points[i].x, this->points[i].y);
+					duplicates = true;
+				}
+			}
+		}
+		order.resize(nPoints);
+		for (unsigned int k = 0; k < nPoints; k++) {
+			order[k] = keys[k].second;
+		}
+	}
+
+	/* Ghost triangles are in conflict with points strictly outside of their hull edge
+	 * and with points on its interior, real triangles with points inside their circumcircle */
+	bool TriangleGenerator::inConflict(unsigned int t, unsigned int p) const {
+		const Triangle& tri = this->triangles[t];
+		const Point& q = this->points[p];
+		for (unsigned int k = 0; k < 3; k++) {
+			if (tri.v[k] == TriangleGenerator::INFINITE) {
+				const Point& a = this->points[tri.v[(k + 1) % 3]];
+				const Point& b = this->points[tri.v[(k + 2) % 3]];
+				long o = TriangleGenerator::orient(a, b, q);
+				if (o != 0) {
+					return o > 0;
+				}
+				return (q.x - a.x) * (b.x - a.x) + (q.y - a.y) * (b.y - a.y) > 0
+					&& (q.x - b.x) * (a.x - b.x) + (q.y - b.y) * (a.y - b.y) > 0;
+			}
+		}
+		return TriangleGenerator::inCircle(this->points[tri.v[0]], this->points[tri.v[1]], this->points[tri.v[2]], q);
+	}
+
+	unsigned int TriangleGenerator::newTriangle(unsigned int a, unsigned int b, unsigned int c) {
+		unsigned int t;
+		if (this->freeTriangles.empty()) {
+			t = this->triangles.size();
+			this->triangles.emplace_back();
+			this->conflictStamp.push_back(0);
+			this->noConflictStamp.push_back(0);
+		} else {
+			t = this->freeTriangles.back();
+			this->freeTriangles.pop_back();
+		}
+		Triangle& tri = this->triangles[t];
+		tri.v[0] = a;
+		tri.v[1] = b;
+		tri.v[2] = c;
+		return t;
+	}
+
+	/* Triangle abc and one ghost triangle for each of its edges */
+	void TriangleGenerator::initialize(unsigned int a, unsigned int b, unsigned int c) {
+		if (TriangleGenerator::orient(this->points[a], this->points[b], this->points[c]) < 0) {
+			std::swap(b, c);
+		}
+		const unsigned int inf = TriangleGenerator::INFINITE;
+		unsigned int abc = this->newTriangle(a, b, c);
+		unsigned int ab = this->newTriangle(b, a, inf);
+		unsigned int bc = this->newTriangle(c, b, inf);
+		unsigned int ca = this->newTriangle(a, c, inf);
+		auto link = [this](unsigned int t, unsigned int n0, unsigned int n1, unsigned int n2) {
+			Triangle& tri = this->triangles[t];
+			tri.n[0] = n0;
+			tri.n[1] = n1;
+			tri.n[2] = n2;
+		};
+		link(abc, bc, ca, ab);
+		link(ab, ca, bc, abc);
+		link(bc, ab, ca, abc);
+		link(ca, bc, ab, abc);
+		this->last = abc;
+	}
+
+	/* Walks from the last created triangle towards the point by crossing edges the point
+	 * lies strictly behind. The walk terminates in a Delaunay triangulation and ends either
+	 * in the triangle containing the point or in the ghost triangle of a hull edge it lies behind. */
+	unsigned int TriangleGenerator::locate(unsigned int p) const {
+		const Point& q = this->points[p];
+		unsigned int t = this->last;
+		for (unsigned int k = 0; k < 3; k++) {
+			if (this->triangles[t].v[k] == TriangleGenerator::INFINITE) {
+				t = this->triangles[t].n[k];
+				break;
+			}
+		}
+		while (true) {
+			const Triangle& tri = this->triangles[t];
+			if (tri.v[0] == TriangleGenerator::INFINITE || tri.v[1] == TriangleGenerator::INFINITE || tri.v[2] == TriangleGenerator::INFINITE) {
+				return t;
+			}
+			unsigned int next = t;
 			for (unsigned int i = 0; i < 3; i++) {
-				GEOM_FADE2D::Point2* p1 = tp->getCorner(i);
-				GEOM_FADE2D::Point2* p2 = tp->getCorner((i + 1) % 3);
-				double p1x = p1->x();
-				double p1y = p1->y();
-				double p2x = p2->x();
-				double p2y = p2->y();
-				yMap& p1ym = xMapGet(idxMap, p1x, dummyMap);
-				yMap& p2ym = xMapGet(idxMap, p2x, dummyMap);
-				unsigned int ip1 = yMapGet(p1ym, p1y, dummyIdx);
-				unsigned int ip2 = yMapGet(p2ym, p2y, dummyIdx);
-				ret->addEdgeSymSafe(ip1, ip2);
-			}
-		}
-#else
-		(void)nPoints;
-		(void)rgen;
-#endif
+				if (TriangleGenerator::orient(this->points[tri.v[(i + 1) % 3]], this->points[tri.v[(i + 2) % 3]], q) < 0) {
+					next = tri.n[i];
+					break;
+				}
+			}
+			if (next == t) {
+				return t;
+			}
+			t = next;
+		}
+	}
+
+	/* Bowyer-Watson step: The triangles in conflict with the point form a star-shaped cavity,
+	 * which is collected by a search from the located triangle. Every boundary edge a->b of
+	 * the cavity becomes a triangle (a, b, p), which is linked to the triangle outside of
+	 * the edge and to the new triangles starting and ending at b and a. The side of the outer
+	 * triangle is found before any slot is reused, as a removed triangle may share its index
+	 * with a new one. */
+	void TriangleGenerator::insert(unsigned int p) {
+		unsigned int t = this->locate(p);
+		this->stamp++;
+		this->cavity.clear();
+		this->boundary.clear();
+		this->conflictStamp[t] = this->stamp;
+		this->cavity.push_back(t);
+		for (unsigned int k = 0; k < this->cavity.size(); k++) {
+			unsigned int c = this->cavity[k];
+			for (unsigned int i = 0; i < 3; i++) {
+				unsigned int nb = this->triangles[c].n[i];
+				if (this->conflictStamp[nb] == this->stamp) {
+					continue;
+				}
+				if (this->noConflictStamp[nb] != this->stamp && this->inConflict(nb, p)) {
+					this->conflictStamp[nb] = this->stamp;
+					this->cavity.push_back(nb);
+				} else {
+					this->noConflictStamp[nb] = this->stamp;
+					Edge e;
+					e.a = this->triangles[c].v[(i + 1) % 3];
+					e.b = this->triangles[c].v[(i + 2) % 3];
+					e.outer = nb;
+					e.side = 0;
+					while (this->triangles[nb].n[e.side] != c) {
+						e.side++;
+					}
+					this->boundary.push_back(e);
+				}
+			}
+		}
+		for (unsigned int c : this->cavity) {
+			this->triangles[c].v[0] = TriangleGenerator::DEAD;
+			this->freeTriangles.push_back(c);
+		}
+		this->cavity.clear();
+		unsigned int infSlot = this->points.size();
+		for (const Edge& e : this->boundary) {
+			unsigned int nt = this->newTriangle(e.a, e.b, p);
+			this->triangles[nt].n[2] = e.outer;
+			this->triangles[e.outer].n[e.side] = nt;
+			this->startingAt[e.a == TriangleGenerator::INFINITE ? infSlot : e.a] = nt;
+			this->cavity.push_back(nt);
+		}
+		for (unsigned int nt : this->cavity) {
+			unsigned int b = this->triangles[nt].v[1];
+			unsigned int next = this->startingAt[b == TriangleGenerator::INFINITE ? infSlot : b];
+			this->triangles[nt].n[0] = next;
+			this->triangles[next].n[1] = nt;
+		}
+		this->last = this->cavity.front();
+	}
+
+	SimpleGraph<unsigned int>* TriangleGenerator::generate(unsigned int nPoints, unsigned long seed) {
+		SimpleGraph<unsigned int>* ret = new SimpleGraph<unsigned int>();
+		for (unsigned int i = 0; i < nPoints; i++) {
+			ret->addVertex(i);
+		}
+		if (nPoints < 2) {
+			return ret;
+		}
+		std::vector<unsigned int> order;
+		this->drawPoints(nPoints, seed, order);
+		/* The first triangle needs three points, which are not collinear */
+		unsigned int third = 2;
+		while (third < nPoints && TriangleGenerator::orient(this->points[order[0]], this->points[order[1]], this->points[order[third]]) == 0) {
+			third++;
+		}
+		if (third == nPoints) {
+			/* All points on one line are triangulated by a path */
+			std::sort(order.begin(), order.end(), [this](unsigned int u, unsigned int v) {
+				return std::make_pair(this->points[u].x, this->points[u].y) < std::make_pair(this->points[v].x, this->points[v].y);
+			});
+			GGenerator::addEdgeBlocks(ret, 1, [&order](unsigned long, const GGenerator::EdgeCallback& addEdge) {
+				for (unsigned int k = 1; k < order.size(); k++) {
+					addEdge(order[k - 1], order[k]);
+				}
+			}, false);
+			return ret;
+		}
+		this->triangles.reserve(2ul * nPoints + 2);
+		this->conflictStamp.reserve(2ul * nPoints + 2);
+		this->noConflictStamp.reserve(2ul * nPoints + 2);
+		this->startingAt.resize(nPoints + 1);
+		this->initialize(order[0], order[1], order[third]);
+		for (unsigned int k = 2; k < nPoints; k++) {
+			if (k != third) {
+				this->insert(order[k]);
+			}
+		}
+		/* Every edge lies in two triangles, the one with the smaller index adds it */
+		const unsigned long trianglesPerBlock = 1 << 16;
+		unsigned long nTriangles = this->triangles.size();
+		GGenerator::addEdgeBlocks(ret, (nTriangles + trianglesPerBlock - 1) / trianglesPerBlock, [this, nTriangles, trianglesPerBlock](unsigned long b, const GGenerator::EdgeCallback& addEdge) {
+			for (unsigned long t = b * trianglesPerBlock; t < std::min(nTriangles, (b + 1) * trianglesPerBlock); t++) {
+				const Triangle& tri = this->triangles[t];
+				if (tri.v[0] == TriangleGenerator::DEAD) {
+					continue;
+				}
+				for (unsigned int i = 0; i < 3; i++) {
+					unsigned int u = tri.v[(i + 1) % 3], v = tri.v[(i + 2) % 3];
+					if (u != TriangleGenerator::INFINITE && v != TriangleGenerator::INFINITE && t < tri.n[i]) {
+						addEdge(u, v);
+					}
+				}
+			}
+		}, false);
 		return ret;
 	}
 }